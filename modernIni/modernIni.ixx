@@ -4,17 +4,457 @@ module;
 #include <map>
 #include <string>
 #include <sstream>
-#include <regex>
 #include <ranges>
 #include <charconv>
 #include <type_traits>
 #include <format>
 #include <optional>
+#include <array>
+#include <string_view>
+#include <vector>
+#include <stdexcept>
+#include <iterator>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <span>
+#include <deque>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <future>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+#include <cstring>
+#include <limits>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#endif
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 export module modernIni;
 
+namespace modernIni::detail {
+	// write `value` to the stream, escaping newlines and backslashes
+	void writeEscaped(std::ostream& output, std::string_view value) {
+		size_t runStart = 0;
+		for (size_t i = 0; i < value.size(); ++i) {
+			const char letter = value[i];
+			if (letter != '\n' && letter != '\\') {
+				continue;
+			}
+			output.write(value.data() + runStart, i - runStart);
+			output << '\\' << (letter == '\n' ? 'n' : '\\');
+			runStart = i + 1;
+		}
+		output.write(value.data() + runStart, value.size() - runStart);
+	}
+
+	// runs `fn(i)` for every i in [0, count) on up to `threads` threads, exceptions are rethrown on the calling thread
+	template<typename F>
+	void parallelFor(size_t count, size_t threads, F&& fn) {
+		if (threads == 0) {
+			threads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		threads = std::min(threads, count);
+
+		std::atomic<size_t> next = 0;
+		std::exception_ptr error;
+		std::mutex errorMutex;
+		auto worker = [&]() {
+			for (size_t i = next++; i < count; i = next++) {
+				try {
+					fn(i);
+				} catch (...) {
+					std::lock_guard lock(errorMutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+				}
+			}
+		};
+
+		std::vector<std::thread> workers;
+		if (threads > 1) {
+			workers.reserve(threads - 1);
+			for (size_t i = 1; i < threads; ++i) {
+				workers.emplace_back(worker);
+			}
+		}
+		worker();
+		for (std::thread& thread : workers) {
+			thread.join();
+		}
+
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	/**
+	 * Stream buffer, that is filled with blocks by one thread and read by another.
+	 * At most `maxBlocks` blocks are queued, `push()` waits until the reader caught up.
+	 */
+	class BlockStreamBuf : public std::streambuf {
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::string> blocks;
+		size_t maxBlocks;
+		bool finished = false;
+		bool cancelled = false;
+		std::string current;
+
+	protected:
+		int_type underflow() override {
+			std::unique_lock lock(mutex);
+			condition.wait(lock, [this] {
+				return !blocks.empty() || finished;
+			});
+			if (blocks.empty()) {
+				return traits_type::eof();
+			}
+			current = std::move(blocks.front());
+			blocks.pop_front();
+			condition.notify_all();
+
+			setg(current.data(), current.data(), current.data() + current.size());
+			return traits_type::to_int_type(current.front());
+		}
+
+	public:
+		explicit BlockStreamBuf(size_t new_max_blocks) :
+			maxBlocks(new_max_blocks) { }
+
+		// false if the reader stopped reading
+		bool push(std::string block) {
+			std::unique_lock lock(mutex);
+			condition.wait(lock, [this] {
+				return blocks.size() < maxBlocks || cancelled;
+			});
+			if (cancelled) {
+				return false;
+			}
+			if (!block.empty()) {
+				blocks.push_back(std::move(block));
+			}
+			condition.notify_all();
+			return true;
+		}
+
+		// no more blocks follow
+		void finish() {
+			std::lock_guard lock(mutex);
+			finished = true;
+			condition.notify_all();
+		}
+
+		// called by the reader, when it stops before the end
+		void cancel() {
+			std::lock_guard lock(mutex);
+			cancelled = true;
+			condition.notify_all();
+		}
+	};
+
+	// reverse of `writeEscaped()`
+	void decodeValue(std::string_view value, std::string& decoded) {
+		decoded.clear();
+		decoded.reserve(value.size());
+		bool decodeNext = false;
+		for (auto letter : value) {
+			if (decodeNext) {
+				decodeNext = false;
+				if (letter == '\\') {
+					decoded += letter;
+				} else if (letter == 'n') {
+					decoded += '\n';
+				}
+			} else if (letter == '\\') {
+				decodeNext = true;
+			} else {
+				decoded += letter;
+			}
+		}
+	}
+	std::string decodeValue(std::string_view value) {
+		std::string decoded;
+		decodeValue(value, decoded);
+		return decoded;
+	}
+
+	// appends a key of a journal or `diff()` path, `\`, `[`, `]` and `=` are escaped with a `\`, line breaks as `\n`
+	void appendPathSegment(std::string& path, std::string_view segment) {
+		for (const char letter : segment) {
+			if (letter == '\n') {
+				path += "\\n";
+				continue;
+			}
+			if (letter == '\\' || letter == '[' || letter == ']' || letter == '=') {
+				path += '\\';
+			}
+			path += letter;
+		}
+	}
+
+	// reverse of `appendPathSegment()`, `path` is moved behind `terminator`, false if it wasn't found
+	bool readPathSegment(std::string_view& path, char terminator, std::string& segment) {
+		segment.clear();
+		size_t pos = 0;
+		for (; pos < path.size() && path[pos] != terminator; ++pos) {
+			if (path[pos] == '\\' && pos + 1 < path.size()) {
+				++pos;
+				segment += path[pos] == 'n' ? '\n' : path[pos];
+			} else {
+				segment += path[pos];
+			}
+		}
+		const bool found = pos < path.size();
+		path.remove_prefix(found ? pos + 1 : pos);
+		return found;
+	}
+
+	// true if `path` ends with an unescaped `]`, so it is the path of a section
+	bool isSectionPath(std::string_view path) {
+		if (!path.ends_with(']')) {
+			return false;
+		}
+		size_t backslashes = 0;
+		for (size_t pos = path.size() - 1; pos > 0 && path[pos - 1] == '\\'; --pos) {
+			++backslashes;
+		}
+		return backslashes % 2 == 0;
+	}
+
+	// strips leading/trailing spaces and collapses runs of spaces into one, `buffer` is only used when something has to be collapsed
+	std::string_view collapseSpaces(std::string_view value, std::string& buffer) {
+		const size_t begin = value.find_first_not_of(' ');
+		if (begin == std::string_view::npos) {
+			return {};
+		}
+		value = value.substr(begin, value.find_last_not_of(' ') + 1 - begin);
+		if (value.find("  ") == std::string_view::npos) {
+			return value;
+		}
+
+		buffer.clear();
+		for (char letter : value) {
+			if (letter == ' ' && !buffer.empty() && buffer.back() == ' ') {
+				continue;
+			}
+			buffer += letter;
+		}
+		return buffer;
+	}
+
+	// byte offsets of a line, the value range is only set for `key=value` lines
+	struct LineSource {
+		size_t lineBegin;
+		size_t lineEnd;
+		size_t valueBegin;
+		size_t valueEnd;
+		// starting at 1
+		size_t number;
+	};
+
+	// totals of a `tokenize()` call
+	struct TokenizeResult {
+		size_t bytes;
+		size_t lines;
+	};
+
+	// reused between lines, so tokenizing doesn't allocate for every line
+	struct TokenBuffers {
+		std::string key;
+		std::string value;
+		std::string decoded;
+		std::vector<std::string_view> categories;
+	};
+
+	/**
+	 * Splits one line into tokens and passes them to the handler:
+	 * `handler.value(key, value, LineSource)` for `key=value` lines (with spaces stripped and the value decoded)
+	 * and `handler.section(categories, LineSource)` for `[cat][subcat]` lines. All other lines are ignored.
+	 * The views are only valid during the call.
+	 */
+	template<typename Handler>
+	void tokenizeLine(std::string_view line, LineSource source, Handler& handler, TokenBuffers& buffers) {
+		if (line.empty()) {
+			return;
+		}
+		const size_t lineBegin = source.lineBegin;
+		source.valueBegin = source.valueEnd = lineBegin + line.size();
+
+		const size_t splitPos = line.find('=');
+		if (splitPos != std::string_view::npos) {
+			std::string_view key = collapseSpaces(line.substr(0, splitPos), buffers.key);
+			std::string_view value = collapseSpaces(line.substr(splitPos + 1), buffers.value);
+			if (value.find('\\') != std::string_view::npos) {
+				// handlers can replace the decoding, e.g. to measure it
+				if constexpr (requires { handler.decode(value, buffers.decoded); }) {
+					handler.decode(value, buffers.decoded);
+				} else {
+					decodeValue(value, buffers.decoded);
+				}
+				value = buffers.decoded;
+			}
+
+			const size_t valueBegin = line.find_first_not_of(' ', splitPos + 1);
+			if (valueBegin != std::string_view::npos) {
+				source.valueBegin = lineBegin + valueBegin;
+				source.valueEnd = lineBegin + line.find_last_not_of(' ') + 1;
+			}
+
+			handler.value(key, value, source);
+		} else if (line.find('[') != std::string_view::npos) {
+			// every `[name]` without nested brackets is a category
+			buffers.categories.clear();
+			size_t pos = line.find('[');
+			while (pos != std::string_view::npos) {
+				const size_t end = line.find_first_of("[]", pos + 1);
+				if (end == std::string_view::npos) {
+					break;
+				}
+				if (line[end] == ']' && end > pos + 1) {
+					buffers.categories.push_back(line.substr(pos + 1, end - pos - 1));
+					pos = line.find('[', end + 1);
+				} else {
+					pos = line.find('[', pos + 1);
+				}
+			}
+
+			handler.section(buffers.categories, source);
+		}
+	}
+
+	// bytes requested from the `streambuf` at once by `tokenize(std::istream&)`
+	constexpr size_t streamBlockSize = 64 * 1024;
+
+	/**
+	 * Reads `input` in blocks directly from its `streambuf` into one reused buffer, lines that cross a block boundary
+	 * are moved to the front of the buffer before the next block is appended. This avoids a `std::getline()` with its
+	 * sentry and string per line, also for custom `streambuf`s (e.g. decompression).
+	 */
+	template<typename Handler>
+	TokenizeResult tokenize(std::istream& input, Handler& handler) {
+		const std::istream::sentry sentry(input, true);
+		if (!sentry) {
+			return { 0, 0 };
+		}
+
+		TokenBuffers buffers;
+		std::vector<char> block(streamBlockSize);
+		// the bytes in [0, filled) are read, but not yet tokenized
+		size_t filled = 0;
+		size_t offset = 0;
+		size_t number = 0;
+
+		while (true) {
+			if (block.size() - filled < streamBlockSize / 2) {
+				// a single line is longer than the buffer
+				block.resize(block.size() * 2);
+			}
+			const std::streamsize count = input.rdbuf()->sgetn(block.data() + filled, static_cast<std::streamsize>(block.size() - filled));
+			if (count <= 0) {
+				break;
+			}
+
+			const std::string_view data(block.data(), filled + static_cast<size_t>(count));
+			size_t lineStart = 0;
+			for (size_t end = data.find('\n'); end != std::string_view::npos; end = data.find('\n', lineStart)) {
+				const size_t lineBegin = offset;
+				offset += end - lineStart + 1;
+
+				tokenizeLine(data.substr(lineStart, end - lineStart), { lineBegin, offset, 0, 0, ++number }, handler, buffers);
+				lineStart = end + 1;
+			}
+
+			filled = data.size() - lineStart;
+			std::memmove(block.data(), block.data() + lineStart, filled);
+		}
+
+		// the last line isn't terminated by a newline
+		if (filled > 0) {
+			const size_t lineBegin = offset;
+			offset += filled;
+			tokenizeLine(std::string_view(block.data(), filled), { lineBegin, offset, 0, 0, ++number }, handler, buffers);
+		}
+		input.setstate(std::ios::eofbit);
+		return { offset, number };
+	}
+
+	template<typename Handler>
+	TokenizeResult tokenize(std::string_view input, Handler& handler) {
+		TokenBuffers buffers;
+		size_t offset = 0;
+		size_t number = 0;
+
+		while (offset < input.size()) {
+			size_t end = input.find('\n', offset);
+			const size_t lineBegin = offset;
+			if (end == std::string_view::npos) {
+				end = input.size();
+				offset = end;
+			} else {
+				offset = end + 1;
+			}
+
+			tokenizeLine(input.substr(lineBegin, end - lineBegin), { lineBegin, offset, 0, 0, ++number }, handler, buffers);
+		}
+		return { offset, number };
+	}
+
+	// `key` as an array index, only plain digits without leading zeros are accepted
+	std::optional<size_t> parseIndex(std::string_view key) {
+		if (key.empty() || (key.size() > 1 && key.front() == '0')) {
+			return std::nullopt;
+		}
+		size_t index = 0;
+		auto [end, ec] = std::from_chars(key.data(), key.data() + key.size(), index);
+		if (ec != std::errc() || end != key.data() + key.size()) {
+			return std::nullopt;
+		}
+		return index;
+	}
+
+	class StructParser;
+	template<typename Handler>
+	class SchemaValidator;
+
+	// types that are serialized as a single `key=value` line
+	template<typename T>
+	constexpr bool isIniValue = std::is_same_v<T, std::string> || std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_enum_v<T>;
+	template<typename T>
+	constexpr bool isIniValue<std::optional<T>> = isIniValue<T>;
+}
+
 export namespace modernIni {
 	class Ini;
+	class IniWriter;
+	class Schema;
+	struct IniDiff;
+	class BinaryIni;
 
 	template<typename T>
 	concept HasFromIni =
@@ -34,6 +474,12 @@ export namespace modernIni {
 	template<typename T>
 	concept EnumHasNoToIni = std::is_enum_v<T> && !HasToIni<T>;
 
+	template<typename T>
+	concept HasToIniWriter =
+		requires(const T& val, IniWriter& writer) {
+		to_ini(val, writer);
+	};
+
 	template<typename T>
 	concept IsFromChars =
 		requires(char* s, T val) {
@@ -42,47 +488,670 @@ export namespace modernIni {
 
 	enum class Type {
 		Object,
-		Value
+		Value,
+		// elements are stored by index, serialized like an object with the keys `0`, `1`, ...
+		Array
 	};
 
+	struct FieldTable;
+
+	/**
+	 * A member of a struct, generated with `makeField()` by the `MODERN_INI_DEFINE_TYPE_*` macros.
+	 * The struct is passed as `void*`, so nested structs can be walked without knowing their type.
+	 */
+	struct FieldBinding {
+		std::string_view name;
+		// reads the member from an `Ini`, used by `from_ini_fields()`
+		void (*bind)(void* obj, const Ini& ini) = nullptr;
+		// parses a single value into the member, only set when the member is a single value
+		void (*assign)(void* member, std::string_view value) = nullptr;
+		// checks if a value can be converted into the member, only set when the member is a single value
+		bool (*check)(std::string_view value) = nullptr;
+		// fields of the member, only set when the member is a struct with `MODERN_INI_DEFINE_TYPE_*`
+		FieldTable (*table)() = nullptr;
+		void* (*member)(void* obj) = nullptr;
+		// assigns the member to `ini`, used by `to_ini_fields()`
+		void (*store)(const void* obj, Ini& ini) = nullptr;
+		// `writer.write_value()` or `writer.write_section()` of the member, used by `to_ini_fields()`
+		void (*write)(const void* obj, IniWriter& writer, std::string_view name, bool section) = nullptr;
+	};
+
+	// all fields of a struct
+	struct FieldTable {
+		// sorted by name
+		std::span<const FieldBinding> fields;
+		// in the order of the macro, sections are written in this order
+		std::span<const FieldBinding> declared;
+		// missing fields throw `std::out_of_range`
+		bool required = true;
+	};
+
+	template<typename T>
+	concept HasIniFields =
+		requires {
+		{ ini_fields(std::type_identity<T>{}) } -> std::same_as<FieldTable>;
+	};
+
+	// sorts the fields by name, so `from_ini_fields()` can match them against the sorted sub elements
+	template<size_t Size>
+	constexpr std::array<FieldBinding, Size> sortFields(std::array<FieldBinding, Size> fields) {
+		std::ranges::sort(fields, {}, &FieldBinding::name);
+		return fields;
+	}
+
+	// name of an enum value, generated by `MODERN_INI_SERIALIZE_ENUM`
+	template<typename T>
+	struct EnumName {
+		std::string_view name;
+		T value;
+	};
+
+	// the names of an enum, sorted by name for `enumFromName()` and by value for `enumToName()`
+	template<typename T, size_t Size>
+	struct EnumNameTable {
+		std::array<EnumName<T>, Size> byName;
+		std::array<EnumName<T>, Size> byValue;
+	};
+
+	// `declared` is in declaration order, aliases keep their declaration order in `byValue`, so the first name of a value is found
+	template<typename T, size_t Size>
+	constexpr EnumNameTable<T, Size> makeEnumNameTable(const std::array<EnumName<T>, Size>& declared) {
+		EnumNameTable<T, Size> table{declared, declared};
+		std::ranges::sort(table.byName, {}, &EnumName<T>::name);
+
+		std::array<size_t, Size> order{};
+		for (size_t i = 0; i < Size; ++i) {
+			order[i] = i;
+		}
+		std::ranges::sort(order, [&declared](size_t lhs, size_t rhs) {
+			if (declared[lhs].value != declared[rhs].value) {
+				return declared[lhs].value < declared[rhs].value;
+			}
+			return lhs < rhs;
+		});
+		for (size_t i = 0; i < Size; ++i) {
+			table.byValue[i] = declared[order[i]];
+		}
+		return table;
+	}
+
+	// enums with `MODERN_INI_SERIALIZE_ENUM`, their names can be converted without going through an `Ini`
+	template<typename T>
+	concept HasEnumNames = std::is_enum_v<T> &&
+		requires(const T& val) {
+		{ ini_enum_names(std::type_identity<T>{}) } -> std::same_as<std::span<const EnumName<T>>>;
+		{ ini_enum_name(val) } -> std::same_as<std::string_view>;
+	};
+
+	// `val` is only changed, if `name` is found
+	template<typename T>
+	constexpr bool enumFromName(std::span<const EnumName<T>> names, std::string_view name, T& val) {
+		auto found = std::ranges::lower_bound(names, name, {}, &EnumName<T>::name);
+		if (found != names.end() && found->name == name) {
+			val = found->value;
+			return true;
+		}
+		return false;
+	}
+
+	// `values` has to be sorted by value, empty if `val` has no name
+	template<typename T>
+	constexpr std::string_view enumToName(std::span<const EnumName<T>> values, T val) {
+		auto found = std::ranges::lower_bound(values, val, {}, &EnumName<T>::value);
+		if (found != values.end() && found->value == val) {
+			return found->name;
+		}
+		return {};
+	}
+
+	// reasons why `Ini::try_get()` couldn't read a value
+	enum class IniError {
+		MissingKey,
+		// e.g. a section where a single value was expected
+		WrongType,
+		// the value couldn't be converted, e.g. `abc` into an int
+		ParseError
+	};
+
+	/**
+	 * Counters of `operator>>`, `operator<<` and `from_ini()` (through `Ini::get()`/`Ini::get_to()`).
+	 * Only operations on threads with an active `IniMetrics::Scope` are recorded, without a scope they only check a thread local pointer.
+	 */
+	struct IniMetrics {
+		// `operator>>` without `build` and `decode`
+		std::chrono::nanoseconds tokenize{};
+		// inserting the tokens into the tree
+		std::chrono::nanoseconds build{};
+		// decoding escape sequences in values
+		std::chrono::nanoseconds decode{};
+		std::chrono::nanoseconds write{};
+		std::chrono::nanoseconds bind{};
+
+		uint64_t parses = 0;
+		uint64_t writes = 0;
+		uint64_t binds = 0;
+		uint64_t lines = 0;
+		uint64_t bytesRead = 0;
+		uint64_t bytesWritten = 0;
+		uint64_t nodesCreated = 0;
+		// only counted, if the allocator reports to `record_allocation()`
+		uint64_t allocations = 0;
+		uint64_t allocatedBytes = 0;
+
+		// records the operations of the current thread into `metrics` until it is destroyed, scopes can be nested
+		class Scope {
+		private:
+			IniMetrics* previous;
+
+		public:
+			explicit Scope(IniMetrics& metrics);
+			~Scope();
+
+			Scope(const Scope&) = delete;
+			Scope& operator=(const Scope&) = delete;
+		};
+
+		/**
+		 * Called by a counting allocator (e.g. a replaced `operator new`), allocations are only recorded while
+		 * a recorded operation runs on the current thread.
+		 */
+		static void record_allocation(size_t bytes);
+
+		// combines the metrics of several threads
+		IniMetrics& operator+=(const IniMetrics& other) {
+			tokenize += other.tokenize;
+			build += other.build;
+			decode += other.decode;
+			write += other.write;
+			bind += other.bind;
+			parses += other.parses;
+			writes += other.writes;
+			binds += other.binds;
+			lines += other.lines;
+			bytesRead += other.bytesRead;
+			bytesWritten += other.bytesWritten;
+			nodesCreated += other.nodesCreated;
+			allocations += other.allocations;
+			allocatedBytes += other.allocatedBytes;
+			return *this;
+		}
+	};
+}
+
+namespace modernIni::detail {
+	// set by `IniMetrics::Scope`
+	thread_local IniMetrics* activeMetrics = nullptr;
+	// set while an operation is recorded, so nested operations (e.g. `from_ini()` of members) aren't recorded twice
+	thread_local IniMetrics* recordingMetrics = nullptr;
+
+	// the metrics to record the current operation into, `nullptr` if it isn't recorded
+	inline IniMetrics* startRecording() {
+		return recordingMetrics == nullptr ? activeMetrics : nullptr;
+	}
+
+	class Recording {
+	private:
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	public:
+		explicit Recording(IniMetrics& metrics) {
+			recordingMetrics = &metrics;
+		}
+		~Recording() {
+			recordingMetrics = nullptr;
+		}
+
+		Recording(const Recording&) = delete;
+		Recording& operator=(const Recording&) = delete;
+
+		std::chrono::nanoseconds elapsed() const {
+			return std::chrono::steady_clock::now() - start;
+		}
+	};
+
+	// wraps the handler of `tokenize()` to measure the time spent in it and in decoding
+	template<typename Handler>
+	struct MeasuredHandler {
+		Handler& handler;
+		IniMetrics& metrics;
+
+		void value(std::string_view key, std::string_view value, const LineSource& line) {
+			const auto start = std::chrono::steady_clock::now();
+			handler.value(key, value, line);
+			metrics.build += std::chrono::steady_clock::now() - start;
+		}
+
+		void section(const std::vector<std::string_view>& categories, const LineSource& line) {
+			const auto start = std::chrono::steady_clock::now();
+			handler.section(categories, line);
+			metrics.build += std::chrono::steady_clock::now() - start;
+		}
+
+		void decode(std::string_view value, std::string& decoded) {
+			const auto start = std::chrono::steady_clock::now();
+			decodeValue(value, decoded);
+			metrics.decode += std::chrono::steady_clock::now() - start;
+		}
+	};
+
+	// forwards to `target` and counts the written bytes
+	class CountingStreamBuf : public std::streambuf {
+	private:
+		std::streambuf* target;
+
+	protected:
+		int_type overflow(int_type ch) override {
+			if (traits_type::eq_int_type(ch, traits_type::eof())) {
+				return traits_type::not_eof(ch);
+			}
+			if (traits_type::eq_int_type(target->sputc(traits_type::to_char_type(ch)), traits_type::eof())) {
+				return traits_type::eof();
+			}
+			++count;
+			return ch;
+		}
+
+		std::streamsize xsputn(const char* data, std::streamsize size) override {
+			const std::streamsize written = target->sputn(data, size);
+			count += static_cast<uint64_t>(written);
+			return written;
+		}
+
+		int sync() override {
+			return target->pubsync();
+		}
+
+	public:
+		uint64_t count = 0;
+
+		explicit CountingStreamBuf(std::streambuf* new_target) :
+			target(new_target) { }
+	};
+}
+
+export namespace modernIni {
+	IniMetrics::Scope::Scope(IniMetrics& metrics) :
+		previous(detail::activeMetrics) {
+		detail::activeMetrics = &metrics;
+	}
+
+	IniMetrics::Scope::~Scope() {
+		detail::activeMetrics = previous;
+	}
+
+	void IniMetrics::record_allocation(size_t bytes) {
+		if (IniMetrics* metrics = detail::recordingMetrics) {
+			++metrics->allocations;
+			metrics->allocatedBytes += bytes;
+		}
+	}
+}
+
+namespace modernIni::detail {
+	/**
+	 * Conversions of a single value, shared by `Ini::get_to()` and `parse_into()`.
+	 * They return false if `value` couldn't be converted completely, `val` might be changed anyways.
+	 */
+	template<IsFromChars T>
+	bool parseValue(std::string_view value, T& val) {
+		const char* end = value.data() + value.size();
+		auto [ptr, ec] = std::from_chars(value.data(), end, val);
+		return ec == std::errc() && ptr == end;
+	}
+
+	template<EnumHasNoFromIni T>
+	bool parseValue(std::string_view value, T& val) {
+		std::underlying_type_t<T> numVal = 0;
+		const bool parsed = parseValue(value, numVal);
+		val = static_cast<T>(numVal);
+		return parsed;
+	}
+
+	template<HasEnumNames T>
+	bool parseValue(std::string_view value, T& val) {
+		return enumFromName(ini_enum_names(std::type_identity<T>{}), value, val);
+	}
+
+	bool parseValue(std::string_view value, std::string& val) {
+		val = value;
+		return true;
+	}
+
+	bool parseValue(std::string_view value, bool& val) {
+		std::string lowerVal(value);
+		std::transform(lowerVal.begin(), lowerVal.end(), lowerVal.begin(), [](auto& c) {
+			return std::tolower(c);
+		});
+		if (lowerVal == "true" || lowerVal == "on" || lowerVal == "1") {
+			val = true;
+		} else if (lowerVal == "false" || lowerVal == "off" || lowerVal == "0") {
+			val = false;
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	// appends a single value to `output`, the reverse of `parseValue()`
+	template<typename T>
+	void formatValue(std::string& output, const T& val) {
+		if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>) {
+			output += val;
+		} else if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+			std::format_to(std::back_inserter(output), "{}", val);
+		} else if constexpr (HasEnumNames<T>) {
+			output += ini_enum_name(val);
+		} else {
+			static_assert(std::is_enum_v<T>, "Only single values can be formatted");
+			formatValue(output, static_cast<std::underlying_type_t<T>>(val));
+		}
+	}
+}
+
+export namespace modernIni {
+
 	class Ini {
 		friend std::istream& operator>>(std::istream& input, Ini& ini);
+		friend void parse(std::istream& input, Ini& ini, const Schema& schema);
 		friend std::ostream& operator<<(std::ostream& output, const Ini& ini);
-		template<typename Key, typename Val>
-		friend void from_ini(std::map<Key, Val>& obj, const Ini& ini);
+		friend class IniWriter;
+		friend class IniJournal;
+		friend class ConfigHandle;
+		friend IniDiff diff(const Ini& lhs, const Ini& rhs);
+		friend class IniWatcher;
+		friend class IniOverlay;
+		friend class BinaryIni;
+		friend void dump_parallel(std::ostream& output, const Ini& ini, size_t depth, size_t threads);
+		friend void from_ini_fields(void* obj, const Ini& ini, const FieldTable& table);
+		friend class detail::StructParser;
 
 	private:
 		Type type = Type::Value;
 		std::string value;
 		std::string key;
 		std::map<std::string, Ini> subElements;
+		// sub elements of `Type::Array`
+		std::vector<Ini> elements;
 		Ini* parent = nullptr;
 
-	public:
-		Ini() {}
-
-		Ini(const std::string& new_val) :
-			value(new_val), type(Type::Value) { }
+		/**
+		 * Byte offsets of this element in the stream it was parsed from, used by `save_incremental()`.
+		 * Values remember their line and the range of the value itself,
+		 * sections their (last) header line and the position after their last value, where new values are inserted.
+		 * Only parsed elements (or sections with erased parsed elements) have one, elements built in code only pay for the pointer.
+		 */
+		struct Source {
+			static constexpr size_t npos = std::string::npos;
 
-		Ini(const std::string& new_key, const std::string& new_val) : 
-			key(new_key), value(new_val), type(Type::Value) { }
+			size_t lineBegin = npos;
+			size_t lineEnd = npos;
+			size_t valueBegin = npos;
+			size_t valueEnd = npos;
+			size_t insertPos = npos;
+			bool exists = false;
+			// set when the value of this element was changed after parsing
+			bool dirty = false;
+			// source lines of erased sub elements, they are removed on the next `save_incremental()`
+			std::vector<std::pair<size_t, size_t>> erased;
+		};
+		std::unique_ptr<Source> source;
+		// hash of the key, value and sub elements, 0 if it has to be computed again
+		mutable std::atomic<size_t> cachedHash = 0;
 
-		Ini(const std::string& new_key, const std::string& new_val, Ini* new_parent) :
-			key(new_key), value(new_val), type(Type::Value), parent(new_parent) { }
+		/**
+		 * Resets the cached hash of this and all its parents up to the root.
+		 * The walk doesn't stop at a parent without a hash, so a stale hash further up can never survive a change,
+		 * even if the hashes along the path were computed in any order (e.g. `hash()` of a section, then of the root).
+		 */
+		void invalidateHash() {
+			cachedHash.store(0, std::memory_order_relaxed);
+			for (Ini* element = parent; element != nullptr; element = element->parent) {
+				element->cachedHash.store(0, std::memory_order_relaxed);
+			}
+		}
 
-		Ini(std::map<std::string, Ini> new_sub_elements) :
-			subElements(new_sub_elements) {
-			type = Type::Object;
+		void changed() {
+			if (source) {
+				source->dirty = true;
+			}
+			invalidateHash();
+		}
+
+		Source& ensureSource() {
+			if (!source) {
+				source = std::make_unique<Source>();
+			}
+			return *source;
+		}
+
+		bool hasSource() const {
+			return source && source->exists;
+		}
+
+		static uint64_t mixHash(uint64_t hash) {
+			hash ^= hash >> 30;
+			hash *= 0xbf58476d1ce4e5b9;
+			hash ^= hash >> 27;
+			hash *= 0x94d049bb133111eb;
+			hash ^= hash >> 31;
+			return hash;
+		}
+
+		void collectSource(std::vector<std::pair<size_t, size_t>>& ranges) const {
+			if (source) {
+				if (source->lineBegin != Source::npos) {
+					ranges.emplace_back(source->lineBegin, source->lineEnd);
+				}
+				ranges.insert(ranges.end(), source->erased.begin(), source->erased.end());
+			}
+			for (const Ini& element : subElements | std::views::values) {
+				element.collectSource(ranges);
+			}
+			for (const Ini& element : elements) {
+				element.collectSource(ranges);
+			}
+		}
+
+		// remembers the source lines of `element`, which is erased from this, so `save_incremental()` removes them
+		void eraseSource(const Ini& element) {
+			std::vector<std::pair<size_t, size_t>> ranges;
+			element.collectSource(ranges);
+			if (!ranges.empty()) {
+				std::vector<std::pair<size_t, size_t>>& erased = ensureSource().erased;
+				erased.insert(erased.end(), ranges.begin(), ranges.end());
+			}
+		}
+
+		bool isContainer() const {
+			return type == Type::Object || type == Type::Array;
+		}
+
+		// forgets the stream positions of this and its sub elements, e.g. after they were assigned from another stream
+		void resetSource() {
+			source.reset();
+			forEachElement(*this, [](const std::string&, Ini& element) {
+				element.resetSource();
+			});
+		}
+
+		// calls `fn(key, element)` for all sub elements, arrays in index order
+		template<typename Self, typename F>
+		static void forEachElement(Self& self, F&& fn) {
+			if (self.type == Type::Array) {
+				for (auto& element : self.elements) {
+					fn(element.key, element);
+				}
+			} else {
+				for (auto& [subKey, element] : self.subElements) {
+					fn(subKey, element);
+				}
+			}
+		}
+
+		// makes this the parent of its sub elements, needed after this element was moved
+		void setParent(Ini* new_parent) {
+			parent = new_parent;
+			forEachElement(*this, [this](const std::string&, Ini& element) {
+				element.parent = this;
+			});
+		}
+
+		// converts an array into an object with the index keys
+		void toObject();
+
+		struct Edit {
+			size_t begin;
+			size_t end;
+			std::string text;
+		};
+		void collectEdits(std::vector<std::string>& path, std::vector<Edit>& edits, std::string& appended) const;
+		static void diffElements(std::string& path, const Ini& lhs, const Ini& rhs, IniDiff& result);
+		void adoptSource(const Ini& parsed);
+
+		// builds the tree for `operator>>` from the tokens of `detail::tokenize()`
+		struct Builder {
+			Ini& root;
+			Ini* lastCategory;
+			// elements inserted into the tree, for `IniMetrics::nodesCreated`
+			uint64_t nodesCreated = 0;
+
+			explicit Builder(Ini& new_root) :
+				root(new_root), lastCategory(&new_root) {
+				// global element always object
+				root.type = Type::Object;
+				Source& source = root.ensureSource();
+				source.exists = true;
+				source.insertPos = 0;
+				root.invalidateHash();
+			}
+
+			void value(std::string_view key, std::string_view value, const detail::LineSource& line) {
+				std::string name(key);
+				auto [element, inserted] = lastCategory->subElements.try_emplace(name, name, std::string(value), lastCategory);
+				if (inserted) {
+					++nodesCreated;
+					lastCategory->invalidateHash();
+					Source& source = element->second.ensureSource();
+					source.exists = true;
+					source.lineBegin = line.lineBegin;
+					source.lineEnd = line.lineEnd;
+					source.valueBegin = line.valueBegin;
+					source.valueEnd = line.valueEnd;
+				}
+				lastCategory->ensureSource().insertPos = line.lineEnd;
+			}
+
+			void section(const std::vector<std::string_view>& categories, const detail::LineSource& line) {
+				lastCategory = &root;
+				for (std::string_view category : categories) {
+					Ini& parentCategory = *lastCategory;
+					const size_t elementsBefore = parentCategory.subElements.size() + parentCategory.elements.size();
+					lastCategory = &parentCategory.operator[](std::string(category));
+					nodesCreated += parentCategory.subElements.size() + parentCategory.elements.size() - elementsBefore;
+					if (lastCategory->type != Type::Object) {
+						lastCategory->type = Type::Object;
+						lastCategory->invalidateHash();
+					}
+					lastCategory->ensureSource().exists = true;
+				}
+				Source& source = *lastCategory->source;
+				if (lastCategory != &root) {
+					source.lineBegin = line.lineBegin;
+					source.lineEnd = line.lineEnd;
+				}
+				source.insertPos = line.lineEnd;
+			}
+		};
+
+	public:
+		Ini() {}
+
+		/**
+		 * A copy is a root, its sub elements have it as their parent. Containers that adopt it set its parent,
+		 * so a copy never changes the tree it was copied from (e.g. a shared `ConfigHandle` snapshot).
+		 */
+		Ini(const Ini& other) :
+			type(other.type), value(other.value), key(other.key), subElements(other.subElements), elements(other.elements),
+			source(other.source ? std::make_unique<Source>(*other.source) : nullptr), cachedHash(other.cachedHash.load(std::memory_order_relaxed)) {
+			setParent(nullptr);
+		}
+
+		Ini(Ini&& other) noexcept :
+			type(other.type), value(std::move(other.value)), key(std::move(other.key)), subElements(std::move(other.subElements)), elements(std::move(other.elements)),
+			source(std::move(other.source)), cachedHash(other.cachedHash.load(std::memory_order_relaxed)) {
+			setParent(nullptr);
+		}
+
+		/**
+		 * This keeps its parent and its position in the stream it was parsed from, the sub elements are replaced.
+		 * Inside a tree the key is kept as well. The assigned elements are new for `save_incremental()`,
+		 * the lines of the replaced sub elements are removed. Only a root without a source takes over the source of `other`.
+		 */
+		Ini& operator=(const Ini& other) {
+			if (this != &other) {
+				Ini copy(other);
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		Ini& operator=(Ini&& other) noexcept {
+			if (this != &other) {
+				const bool keepSource = parent == nullptr && !hasSource();
+				if (!keepSource) {
+					forEachElement(*this, [this](const std::string&, const Ini& element) {
+						eraseSource(element);
+					});
+				}
+
+				type = other.type;
+				value = std::move(other.value);
+				if (parent == nullptr) {
+					key = std::move(other.key);
+				}
+				subElements = std::move(other.subElements);
+				elements = std::move(other.elements);
+				if (keepSource) {
+					source = std::move(other.source);
+				} else {
+					if (source) {
+						source->dirty = true;
+					}
+					forEachElement(*this, [](const std::string&, Ini& element) {
+						element.resetSource();
+					});
+				}
+				setParent(parent);
+				invalidateHash();
+			}
+			return *this;
+		}
+
+		Ini(const std::string& new_val) :
+			value(new_val), type(Type::Value) { }
+
+		Ini(const std::string& new_key, const std::string& new_val) : 
+			key(new_key), value(new_val), type(Type::Value) { }
+
+		Ini(const std::string& new_key, const std::string& new_val, Ini* new_parent) :
+			key(new_key), value(new_val), type(Type::Value), parent(new_parent) { }
+
+		Ini(std::map<std::string, Ini> new_sub_elements) :
+			subElements(std::move(new_sub_elements)) {
+			type = Type::Object;
+			setParent(parent);
 		}
 
 		Ini(const std::string& new_key, std::map<std::string, Ini> new_sub_elements) :
-			key(new_key), subElements(new_sub_elements) {
+			key(new_key), subElements(std::move(new_sub_elements)) {
 			type = Type::Object;
+			setParent(parent);
 		}
 
 		Ini(const std::string& new_key, std::map<std::string, Ini> new_sub_elements, Ini* new_parent) :
-			key(new_key), subElements(new_sub_elements), parent(new_parent) {
+			key(new_key), subElements(std::move(new_sub_elements)), parent(new_parent) {
 			type = Type::Object;
+			setParent(parent);
 		}
 
 		template<typename T>
@@ -91,287 +1160,3492 @@ export namespace modernIni {
 			this->operator=(val);
 		}
 
-		bool hasValueElements() const {
-			if (type == Type::Value)
-				return false;
+		bool hasValueElements() const {
+			if (type == Type::Value)
+				return false;
+
+			if (type == Type::Array) {
+				return std::ranges::any_of(elements, &Ini::isValue);
+			}
+
+			for (const Ini& element : subElements | std::views::values) {
+				if (element.type == Type::Value) {
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		inline bool isObject() const {
+			return type == Type::Object;
+		}
+
+		inline bool isValue() const {
+			return type == Type::Value;
+		}
+
+		inline bool isArray() const {
+			return type == Type::Array;
+		}
+
+		// number of sub elements, values have none
+		size_t size() const {
+			switch (type)
+			{
+			case Type::Object:
+				return subElements.size();
+			case Type::Array:
+				return elements.size();
+			default:
+				return 0;
+			}
+		}
+
+		/**
+		 * Makes this an array with `size` elements.
+		 * Sub elements of an object with index keys (`0`, `1`, ...) are kept as elements, all others are removed.
+		 */
+		void resize(size_t size);
+
+		// calls `fn(key, element)` for all sub elements, sorted by key for objects and by index for arrays
+		template<typename F>
+		void for_each(F&& fn) const {
+			forEachElement(*this, fn);
+		}
+
+		/**
+		 * Calls `fn(index, element)` for all elements of an array
+		 * and for the sub elements of an object with index keys (`0`, `1`, ...), those are not visited in index order.
+		 */
+		template<typename F>
+		void for_each_index(F&& fn) const {
+			if (type == Type::Array) {
+				for (size_t i = 0; i < elements.size(); ++i) {
+					fn(i, elements[i]);
+				}
+			} else if (type == Type::Object) {
+				for (const auto& [subKey, element] : subElements) {
+					if (const auto index = detail::parseIndex(subKey)) {
+						fn(*index, element);
+					}
+				}
+			}
+		}
+
+		bool has(const std::string& key) const {
+			return find(key) != nullptr;
+		}
+
+		// the sub element `key`, or null if it doesn't exist (or this isn't an object or array)
+		const Ini* find(const std::string& key) const {
+			if (type == Type::Array) {
+				const auto index = detail::parseIndex(key);
+				return index && *index < elements.size() ? &elements[*index] : nullptr;
+			}
+			if (type != Type::Object) {
+				return nullptr;
+			}
+			auto found = subElements.find(key);
+			return found != subElements.end() ? &found->second : nullptr;
+		}
+		Ini* find(const std::string& key) {
+			return const_cast<Ini*>(std::as_const(*this).find(key));
+		}
+
+		/**
+		 * Reads the sub element `key` with a single lookup and without throwing.
+		 * Single values report a `ParseError`, if they can't be converted completely (e.g. `5x` into an int).
+		 * Other types are read with their `from_ini()`, which might still throw (e.g. structs with missing values).
+		 */
+		template<typename T>
+		bool try_get_to(const std::string& key, T& val, IniError& error) const;
+
+#ifdef __cpp_lib_expected
+		template<typename T>
+		std::expected<T, IniError> try_get(const std::string& key) const {
+			T val = {};
+			IniError error = IniError::MissingKey;
+			if (!try_get_to(key, val, error)) {
+				return std::unexpected(error);
+			}
+			return val;
+		}
+#endif
+
+		// the sub element `key`, or `defaultVal` if it doesn't exist or can't be converted
+		template<typename T>
+		T get_or(const std::string& key, T defaultVal) const {
+			T val = {};
+			IniError error = IniError::MissingKey;
+			if (!try_get_to(key, val, error)) {
+				return defaultVal;
+			}
+			return val;
+		}
+
+		std::string get_or(const std::string& key, const char* defaultVal) const {
+			return get_or<std::string>(key, defaultVal);
+		}
+
+		/**
+		 * This produces a string in the ini file category format. e.g. `[cat][subcat][subsubcat]`
+		 */
+		std::string getCategories() const {
+			std::stringstream ss;
+			if (parent != nullptr) {
+				ss << parent->getCategories();
+			}
+			if (!key.empty()) {
+				ss << "[" << key << "]";
+			}
+
+			return ss.str();
+		}
+
+		template<HasFromIni T>
+		void get_to(T& val) const {
+			if (IniMetrics* metrics = detail::startRecording()) [[unlikely]] {
+				const detail::Recording recording(*metrics);
+				from_ini(val, *this);
+				metrics->bind += recording.elapsed();
+				++metrics->binds;
+				return;
+			}
+			from_ini(val, *this);
+		}
+
+		template<IsFromChars T>
+		void get_to(T& val) const {
+			if (!isValue()) return;
+			detail::parseValue(value, val);
+		}
+
+		template<EnumHasNoFromIni T>
+		void get_to(T& val) const {
+			if (!isValue()) return;
+			detail::parseValue(value, val);
+		}
+
+		template<typename T>
+		void get_to(std::optional<T>& val) const {
+			val = get<T>();
+		}
+
+		void get_to(std::string& val) const {
+			if (!isValue()) return;
+			val = value;
+		}
+
+		// the view is only valid as long as this element isn't changed
+		void get_to(std::string_view& val) const {
+			if (!isValue()) return;
+			val = value;
+		}
+
+		void get_to(bool& val) const {
+			if (!isValue()) return;
+			detail::parseValue(value, val);
+		}
+
+		template<typename T>
+		T get() const {
+			T val = {};
+			get_to(val);
+			return std::move(val);
+		}
+
+		/**
+		 * Reads a list value like `1,2,3` into a container, with a different `separator` than the default `,`.
+		 * Objects and arrays are read like with `get_to(val)`. Throws `std::invalid_argument`, if an item can't be converted.
+		 */
+		template<typename Container>
+		void get_to(Container& val, char separator) const;
+
+		template<typename T>
+		T get(char separator) const {
+			T val = {};
+			get_to(val, separator);
+			return val;
+		}
+
+		/**
+		 * Makes this a single value with all `values` joined by `separator`, e.g. `0.1,0.25,0.3`.
+		 * The items must not contain the separator, they can be read with `get_to()`.
+		 */
+		template<typename Range>
+		void set_list(const Range& values, char separator = ',') {
+			type = Type::Value;
+			value.clear();
+			bool first = true;
+			for (const auto& item : values) {
+				if (!first) {
+					value += separator;
+				}
+				first = false;
+				detail::formatValue(value, item);
+			}
+			changed();
+		}
+
+		// erasing from an array converts it into an object, so the other elements keep their index
+		void erase(const std::string& key) {
+			if (isArray()) {
+				toObject();
+			}
+			if (!isObject()) {
+				throw std::out_of_range("Called `erase()` on non-object");
+			}
+
+			auto found = subElements.find(key);
+			if (found == subElements.end()) {
+				return;
+			}
+			eraseSource(found->second);
+			subElements.erase(found);
+			invalidateHash();
+		}
+
+		/**
+		 * Moves the sub elements of `other` into this, values of `other` replace the ones in this and sections are merged.
+		 * Sub elements, that only exist in `other`, are moved as a whole without copying them.
+		 */
+		void merge(Ini&& other) {
+			if (isArray()) {
+				toObject();
+			}
+			if (other.isArray()) {
+				other.toObject();
+			}
+			if (!isObject() || !other.isObject()) {
+				throw std::out_of_range("Called `merge()` on non-object");
+			}
+
+			for (auto& [subKey, element] : other.subElements) {
+				auto found = subElements.find(subKey);
+				if (found != subElements.end() && found->second.isContainer() && element.isContainer()) {
+					found->second.merge(std::move(element));
+					continue;
+				}
+				auto [inserted, _] = subElements.insert_or_assign(subKey, std::move(element));
+				inserted->second.setParent(this);
+			}
+			other.subElements.clear();
+			invalidateHash();
+		}
+
+		Ini& at(const std::string& key) {
+			return const_cast<Ini&>(std::as_const(*this).at(key));
+		}
+		const Ini& at(const std::string& key) const {
+			if (isArray()) {
+				const Ini* element = find(key);
+				if (element == nullptr) {
+					throw std::out_of_range("Invalid index in `at()`");
+				}
+				return *element;
+			}
+			if (!isObject()) {
+				throw std::out_of_range("Called `at()` on non-object");
+			}
+
+			return subElements.at(key);
+		}
+
+		Ini& at(size_t index) {
+			return const_cast<Ini&>(std::as_const(*this).at(index));
+		}
+		const Ini& at(size_t index) const {
+			if (!isArray()) {
+				throw std::out_of_range("Called `at()` on non-array");
+			}
+
+			return elements.at(index);
+		}
+
+		// makes this an array, that is resized to contain `index`
+		Ini& operator[](size_t index) {
+			if (!isArray()) {
+				size_t size = index + 1;
+				for_each_index([&size](size_t elementIndex, const Ini&) {
+					size = std::max(size, elementIndex + 1);
+				});
+				resize(size);
+			} else if (index >= elements.size()) {
+				resize(index + 1);
+			}
+			return elements[index];
+		}
+
+		Ini& operator[](const std::string& key) {
+			if (isArray()) {
+				if (const auto index = detail::parseIndex(key)) {
+					return operator[](*index);
+				}
+				toObject();
+			}
+			auto [found, inserted] = subElements.try_emplace(key);
+			if (inserted || type != Type::Object) {
+				type = Type::Object;
+				invalidateHash();
+			}
+			Ini& element = found->second;
+			element.parent = this;
+			element.key = key;
+			return element;
+		}
+
+		template<HasToIni T>
+		void operator=(const T& val) {
+			// containers keep arrays as they are, to not lose the sources of their elements
+			if (!isArray()) {
+				type = Type::Object;
+			}
+			changed();
+			to_ini(val, *this);
+		}
+
+		template<typename T>
+		requires std::is_integral_v<T> || std::is_floating_point_v<T>
+		void operator=(const T& val) {
+			type = Type::Value;
+			value = std::format("{}", val);
+			changed();
+		}
+
+		template<EnumHasNoToIni T>
+		void operator=(const T& val) {
+			auto newVal = static_cast<std::underlying_type_t<T>>(val);
+			this->operator=(newVal);
+		}
+
+		template<typename T>
+		void operator=(const std::optional<T>& val) {
+			if (val) {
+				this->operator=(val.value());
+			} else {
+				// remove this from parent, if parent exists
+				if (parent) {
+					parent->erase(key);
+				}
+			}
+		}
+
+		void operator=(const std::string& val) {
+			type = Type::Value;
+			value = val;
+			changed();
+		}
+
+		/**
+		 * Writes the changes made since this element was read with `operator>>` back into the file at `path`.
+		 * Changed values are replaced in place, erased elements are removed, new values are inserted after the last value of their section
+		 * and new sections are appended. All other bytes, including comments, stay untouched.
+		 * When the size of the file doesn't change, only the changed bytes are written, otherwise the file is rewritten from the first change on.
+		 * Has to be called on the root element and the file must not be changed by someone else in the meantime.
+		 */
+		void save_incremental(const std::filesystem::path& path);
+
+		/**
+		 * Writes this element into a binary image, that `map_binary()` can read without parsing.
+		 * The text format stays the source of truth, the image is only a cache and has to be written again after changes.
+		 * The file is replaced by renaming a temporary file, existing mappings keep the old content.
+		 * Windows can't replace a file while it is mapped, there this throws `std::runtime_error` while a `BinaryIni` of `path` exists.
+		 */
+		void save_binary(const std::filesystem::path& path) const;
+
+		// maps a file written by `save_binary()`, see `BinaryIni`
+		static BinaryIni map_binary(const std::filesystem::path& path, bool verify = true);
+
+		/**
+		 * Hash of the key, the value and all sub elements, equal elements have the same hash.
+		 * It is cached in every element until it or one of its sub elements is changed, so it is only computed again for the changed path.
+		 * Sub elements are combined independent of their order, so arrays have the same hash as objects with the same index keys.
+		 */
+		size_t hash() const {
+			const size_t cached = cachedHash.load(std::memory_order_relaxed);
+			if (cached != 0) {
+				return cached;
+			}
+
+			uint64_t result = mixHash(std::hash<std::string>{}(key));
+			if (type == Type::Value) {
+				result = mixHash(result ^ mixHash(std::hash<std::string>{}(value) + 1));
+			} else {
+				uint64_t combined = 0;
+				forEachElement(*this, [&combined](const std::string&, const Ini& element) {
+					combined += mixHash(element.hash());
+				});
+				result = mixHash(result ^ mixHash(combined + 2));
+			}
+
+			// 0 marks a missing hash
+			const size_t hash = static_cast<size_t>(result) != 0 ? static_cast<size_t>(result) : 1;
+			cachedHash.store(hash, std::memory_order_relaxed);
+			return hash;
+		}
+
+		bool operator==(const Ini& other) const {
+			if (this == &other) {
+				return true;
+			}
+			// different hashes prove that the trees differ, equal hashes can collide and always need the full comparison below
+			if (key != other.key || hash() != other.hash()) {
+				return false;
+			}
+
+			// an array is equal to an object with the same index keys
+			if ((isArray() || other.isArray()) && type != other.type) {
+				if (!isContainer() || !other.isContainer() || size() != other.size()) {
+					return false;
+				}
+				bool equal = true;
+				forEachElement(*this, [&other, &equal](const std::string& subKey, const Ini& element) {
+					const Ini* otherElement = other.find(subKey);
+					equal = equal && otherElement != nullptr && element == *otherElement;
+				});
+				return equal;
+			}
+
+			if (type != other.type) {
+				return false;
+			}
+
+			switch (type)
+			{
+			case Type::Object:
+				return subElements == other.subElements;
+			case Type::Value:
+				return value == other.value;
+			case Type::Array:
+				return elements == other.elements;
+			default:
+				break;
+			}
+
+			return false;
+		}
+	};
+
+	void Ini::resize(size_t size) {
+		invalidateHash();
+		if (!isArray()) {
+			std::map<std::string, Ini> previous = std::move(subElements);
+			subElements.clear();
+			elements.clear();
+			elements.resize(size);
+			for (auto& [subKey, element] : previous) {
+				const auto index = detail::parseIndex(subKey);
+				if (index && *index < size) {
+					elements[*index] = std::move(element);
+				} else {
+					eraseSource(element);
+				}
+			}
+			type = Type::Array;
+
+			for (size_t i = 0; i < size; ++i) {
+				elements[i].key = std::to_string(i);
+				elements[i].setParent(this);
+			}
+			return;
+		}
+
+		for (size_t i = size; i < elements.size(); ++i) {
+			eraseSource(elements[i]);
+		}
+		const size_t oldSize = elements.size();
+		const Ini* oldData = elements.data();
+		elements.resize(size);
+
+		// when the elements were moved, the parents of their sub elements changed as well
+		for (size_t i = elements.data() == oldData ? oldSize : 0; i < size; ++i) {
+			if (i >= oldSize) {
+				elements[i].key = std::to_string(i);
+			}
+			elements[i].setParent(this);
+		}
+	}
+
+	/**
+	 * Paths of the elements, that differ between two `Ini`, in the journal format `[cat][subcat]key`.
+	 * Like in the journal, `\`, `[`, `]` and `=` in keys are escaped with a `\`, line breaks as `\n`.
+	 * Sections that only exist on one side are listed once with their section path (e.g. `[cat]`), not every value below them.
+	 * A value that became a section (or the other way around) is changed.
+	 */
+	struct IniDiff {
+		std::vector<std::string> added;
+		std::vector<std::string> removed;
+		std::vector<std::string> changed;
+
+		bool empty() const {
+			return added.empty() && removed.empty() && changed.empty();
+		}
+	};
+
+	void Ini::diffElements(std::string& path, const Ini& lhs, const Ini& rhs, IniDiff& result) {
+		/**
+		 * Subtrees with different hashes differ, equal hashes can collide (sub elements are summed up).
+		 * Those are compared structurally, which again only descends into sub elements with equal hashes.
+		 */
+		if (&lhs == &rhs || (lhs.hash() == rhs.hash() && lhs == rhs)) {
+			return;
+		}
+		if (lhs.type == Type::Value || rhs.type == Type::Value) {
+			if (lhs.type != rhs.type || lhs.value != rhs.value) {
+				result.changed.push_back(path);
+			}
+			return;
+		}
+
+		const size_t pathSize = path.size();
+		auto compare = [&path, pathSize, &result](const std::string& subKey, const Ini* lhsElement, const Ini* rhsElement) {
+			const Ini& element = rhsElement != nullptr ? *rhsElement : *lhsElement;
+			if (element.type == Type::Value) {
+				detail::appendPathSegment(path, subKey);
+			} else {
+				path += '[';
+				detail::appendPathSegment(path, subKey);
+				path += ']';
+			}
+
+			if (lhsElement == nullptr) {
+				result.added.push_back(path);
+			} else if (rhsElement == nullptr) {
+				result.removed.push_back(path);
+			} else {
+				diffElements(path, *lhsElement, *rhsElement, result);
+			}
+			path.resize(pathSize);
+		};
+
+		if (lhs.type == Type::Object && rhs.type == Type::Object) {
+			// both maps are sorted, so they are walked in lockstep
+			auto lhsIt = lhs.subElements.begin();
+			auto rhsIt = rhs.subElements.begin();
+			while (lhsIt != lhs.subElements.end() || rhsIt != rhs.subElements.end()) {
+				if (rhsIt == rhs.subElements.end() || (lhsIt != lhs.subElements.end() && lhsIt->first < rhsIt->first)) {
+					compare(lhsIt->first, &lhsIt->second, nullptr);
+					++lhsIt;
+				} else if (lhsIt == lhs.subElements.end() || rhsIt->first < lhsIt->first) {
+					compare(rhsIt->first, nullptr, &rhsIt->second);
+					++rhsIt;
+				} else {
+					compare(lhsIt->first, &lhsIt->second, &rhsIt->second);
+					++lhsIt;
+					++rhsIt;
+				}
+			}
+		} else if (lhs.type == Type::Array && rhs.type == Type::Array) {
+			const size_t size = std::max(lhs.elements.size(), rhs.elements.size());
+			for (size_t i = 0; i < size; ++i) {
+				compare(std::to_string(i), i < lhs.elements.size() ? &lhs.elements[i] : nullptr, i < rhs.elements.size() ? &rhs.elements[i] : nullptr);
+			}
+		} else {
+			// an array and an object, matched by the index keys
+			forEachElement(lhs, [&rhs, &compare](const std::string& subKey, const Ini& element) {
+				compare(subKey, &element, rhs.find(subKey));
+			});
+			forEachElement(rhs, [&lhs, &compare](const std::string& subKey, const Ini& element) {
+				if (lhs.find(subKey) == nullptr) {
+					compare(subKey, nullptr, &element);
+				}
+			});
+		}
+	}
+
+	/**
+	 * Elements, that were added, removed or changed from `lhs` to `rhs`.
+	 * Both trees are walked once, sub elements are matched by walking both sorted maps side by side.
+	 */
+	IniDiff diff(const Ini& lhs, const Ini& rhs) {
+		IniDiff result;
+		std::string path;
+		Ini::diffElements(path, lhs, rhs, result);
+		return result;
+	}
+
+	void Ini::toObject() {
+		type = Type::Object;
+		invalidateHash();
+		for (Ini& element : elements) {
+			std::string subKey = element.key;
+			auto [inserted, _] = subElements.insert_or_assign(std::move(subKey), std::move(element));
+			inserted->second.setParent(this);
+		}
+		elements.clear();
+	}
+
+	// deserialize from stream
+	std::istream& operator>>(std::istream& input, Ini& ini) {
+		if (IniMetrics* metrics = detail::startRecording()) [[unlikely]] {
+			const auto build = metrics->build;
+			const auto decode = metrics->decode;
+
+			const detail::Recording recording(*metrics);
+			Ini::Builder builder(ini);
+			detail::MeasuredHandler<Ini::Builder> handler{ builder, *metrics };
+			const detail::TokenizeResult result = detail::tokenize(input, handler);
+			metrics->tokenize += recording.elapsed() - (metrics->build - build) - (metrics->decode - decode);
+
+			++metrics->parses;
+			metrics->lines += result.lines;
+			metrics->bytesRead += result.bytes;
+			metrics->nodesCreated += builder.nodesCreated;
+			return input;
+		}
+
+		Ini::Builder builder(ini);
+		detail::tokenize(input, builder);
+
+		return input;
+	}
+
+	// serialize to stream
+	std::ostream& operator<<(std::ostream& output, const Ini& ini) {
+		if (IniMetrics* metrics = detail::startRecording()) [[unlikely]] {
+			const detail::Recording recording(*metrics);
+			detail::CountingStreamBuf buffer(output.rdbuf());
+			std::ostream counted(&buffer);
+			counted << ini;
+			if (!counted) {
+				output.setstate(std::ios::badbit);
+			}
+
+			metrics->write += recording.elapsed();
+			++metrics->writes;
+			metrics->bytesWritten += buffer.count;
+			return output;
+		}
+
+		switch (ini.type)
+		{
+		case Type::Object:
+		case Type::Array:
+			// write out this categories key-value pairs
+			Ini::forEachElement(ini, [&output](const std::string&, const Ini& element) {
+				if (element.type == Type::Value) {
+					output << element;
+				}
+			});
+
+			// write out this categories subcategories
+			Ini::forEachElement(ini, [&output](const std::string&, const Ini& element) {
+				// check if object has any Value types elements
+				if (element.isContainer()) {
+					if (element.hasValueElements()) {
+						output << std::endl << element.getCategories() << std::endl;
+					}
+					output << element;
+				}
+			});
+			break;
+		case Type::Value:
+			output << ini.key << "=";
+			detail::writeEscaped(output, ini.value);
+			output << std::endl;
+			break;
+		default:
+			break;
+		}
+		return output;
+	}
+
+	/**
+	 * Serializes like `operator<<`, but the sections up to `depth` levels below `ini` are written into separate buffers on `threads` threads
+	 * (0 uses all available cores). The buffers are concatenated in order, so the output is byte-identical to `operator<<`.
+	 */
+	void dump_parallel(std::ostream& output, const Ini& ini, size_t depth = 1, size_t threads = 0) {
+		if (!ini.isContainer() || depth == 0) {
+			output << ini;
+			return;
+		}
+
+		struct Chunk {
+			const Ini* element;
+			enum { Values, Header, Full } kind;
+		};
+
+		// split the tree into chunks, in the same order `operator<<` writes them
+		std::vector<Chunk> chunks;
+		auto split = [&chunks](auto& self, const Ini& element, size_t remaining) -> void {
+			chunks.push_back({ &element, Chunk::Values });
+			Ini::forEachElement(element, [&self, &chunks, remaining](const std::string&, const Ini& subElement) {
+				if (!subElement.isContainer()) {
+					return;
+				}
+				if (remaining > 1) {
+					chunks.push_back({ &subElement, Chunk::Header });
+					self(self, subElement, remaining - 1);
+				} else {
+					chunks.push_back({ &subElement, Chunk::Full });
+				}
+			});
+		};
+		split(split, ini, depth);
+
+		std::vector<std::string> buffers(chunks.size());
+		detail::parallelFor(chunks.size(), threads, [&chunks, &buffers](size_t i) {
+			const Chunk& chunk = chunks[i];
+			std::ostringstream ss;
+			if (chunk.kind == Chunk::Values) {
+				Ini::forEachElement(*chunk.element, [&ss](const std::string&, const Ini& subElement) {
+					if (subElement.type == Type::Value) {
+						ss << subElement;
+					}
+				});
+			} else {
+				if (chunk.element->hasValueElements()) {
+					ss << std::endl << chunk.element->getCategories() << std::endl;
+				}
+				if (chunk.kind == Chunk::Full) {
+					ss << *chunk.element;
+				}
+			}
+			buffers[i] = ss.str();
+		});
+
+		for (const std::string& buffer : buffers) {
+			output.write(buffer.data(), buffer.size());
+		}
+	}
+
+	/**
+	 * Serializes directly into a stream, without building an `Ini` tree first.
+	 * Sections are opened with `begin_section()` and closed with `end_section()`, their header is written lazily with the first value.
+	 * The values of a section have to be written before its subsections (this is what `operator<<` does as well),
+	 * otherwise they would be read back as part of the last subsection.
+	 */
+	class IniWriter {
+	private:
+		std::ostream& output;
+		std::vector<std::string> path;
+		std::vector<std::string> writtenHeader;
+		bool headerCurrent = true;
+
+		void writeHeader() {
+			if (headerCurrent) {
+				return;
+			}
+			headerCurrent = true;
+
+			if (path == writtenHeader) {
+				return;
+			}
+			if (path.empty()) {
+				throw std::logic_error("Values of the root section have to be written before any section");
+			}
+
+			output << '\n';
+			for (const std::string& category : path) {
+				output << '[' << category << ']';
+			}
+			output << '\n';
+			writtenHeader = path;
+		}
+
+		void writeLine(const std::string& key, std::string_view val) {
+			writeHeader();
+			output << key << '=';
+			detail::writeEscaped(output, val);
+			output << '\n';
+		}
+
+	public:
+		explicit IniWriter(std::ostream& new_output) :
+			output(new_output) { }
+
+		void begin_section(const std::string& key) {
+			path.push_back(key);
+			headerCurrent = false;
+		}
+
+		void end_section() {
+			if (path.empty()) {
+				throw std::logic_error("Called `end_section()` without an open section");
+			}
+			path.pop_back();
+			headerCurrent = false;
+		}
+
+		void write(const std::string& key, const std::string& val) {
+			writeLine(key, val);
+		}
+
+		// write already serialized `key=value` lines into the current section
+		void write_raw(std::string_view lines) {
+			writeHeader();
+			output.write(lines.data(), lines.size());
+		}
+
+		template<typename T>
+		requires std::is_integral_v<T> || std::is_floating_point_v<T>
+		void write(const std::string& key, const T& val) {
+			writeHeader();
+			output << key << '=';
+			std::format_to(std::ostreambuf_iterator<char>(output), "{}", val);
+			output << '\n';
+		}
+
+		template<EnumHasNoToIni T>
+		void write(const std::string& key, const T& val) {
+			write(key, static_cast<std::underlying_type_t<T>>(val));
+		}
+
+		template<typename T>
+		void write(const std::string& key, const std::optional<T>& val) {
+			if (val) {
+				write(key, val.value());
+			}
+		}
+
+		template<HasToIniWriter T>
+		void write(const std::string& key, const T& val) {
+			begin_section(key);
+			to_ini(val, *this);
+			end_section();
+		}
+
+		template<HasEnumNames T>
+		void write(const std::string& key, const T& val) {
+			const std::string_view name = ini_enum_name(val);
+			if (!name.empty()) {
+				writeLine(key, name);
+			}
+		}
+
+		// types that only know how to serialize into an `Ini`
+		template<HasToIni T>
+		requires (!HasToIniWriter<T> && !HasEnumNames<T>)
+		void write(const std::string& key, const T& val) {
+			Ini temp;
+			temp = val;
+			write(key, temp);
+		}
+
+		void write(const std::string& key, const Ini& ini);
+
+		// write all elements of `val` into the current section
+		template<HasToIniWriter T>
+		void write(const T& val) {
+			to_ini(val, *this);
+		}
+
+		/**
+		 * Only writes `val`, if it is serialized as a single value.
+		 * Together with `write_section()` this is used to write all values of an object before its subsections.
+		 */
+		template<typename T>
+		void write_value(const std::string& key, const T& val) {
+			if constexpr (detail::isIniValue<T>) {
+				write(key, val);
+			}
+		}
+
+		// Only writes `val`, if it is serialized as a section
+		template<typename T>
+		void write_section(const std::string& key, const T& val) {
+			if constexpr (!detail::isIniValue<T>) {
+				write(key, val);
+			}
+		}
+	};
+
+	void IniWriter::write(const std::string& key, const Ini& ini) {
+		if (ini.isValue()) {
+			writeLine(key, ini.value);
+			return;
+		}
+
+		begin_section(key);
+		Ini::forEachElement(ini, [this](const std::string& subKey, const Ini& element) {
+			if (element.isValue()) {
+				write(subKey, element);
+			}
+		});
+		Ini::forEachElement(ini, [this](const std::string& subKey, const Ini& element) {
+			if (element.isContainer()) {
+				write(subKey, element);
+			}
+		});
+		end_section();
+	}
+
+	void Ini::collectEdits(std::vector<std::string>& path, std::vector<Edit>& edits, std::string& appended) const {
+		std::stringstream newValues;
+		IniWriter valueWriter(newValues);
+
+		forEachElement(*this, [&](const std::string& subKey, const Ini& element) {
+			const bool wasValue = element.source && element.source->valueBegin != Source::npos;
+
+			if (element.type == Type::Value) {
+				if (wasValue) {
+					if (element.source->dirty) {
+						std::stringstream ss;
+						detail::writeEscaped(ss, element.value);
+						edits.push_back({ element.source->valueBegin, element.source->valueEnd, ss.str() });
+					}
+					return;
+				}
+
+				// new value, or a section that became a value
+				std::vector<std::pair<size_t, size_t>> ranges;
+				element.collectSource(ranges);
+				for (const auto& [begin, end] : ranges) {
+					edits.push_back({ begin, end, "" });
+				}
+				valueWriter.write(subKey, element);
+				return;
+			}
+
+			if (element.hasSource() && !wasValue) {
+				path.push_back(subKey);
+				element.collectEdits(path, edits, appended);
+				path.pop_back();
+				return;
+			}
+
+			// new section, or a value that became a section
+			if (wasValue) {
+				edits.push_back({ element.source->lineBegin, element.source->lineEnd, "" });
+			}
+			std::stringstream ss;
+			IniWriter writer(ss);
+			for (const std::string& category : path) {
+				writer.begin_section(category);
+			}
+			writer.write(subKey, element);
+			appended += ss.str();
+		});
+
+		if (source) {
+			for (const auto& [begin, end] : source->erased) {
+				edits.push_back({ begin, end, "" });
+			}
+		}
+
+		if (newValues.tellp() > 0) {
+			if (source && source->insertPos != Source::npos) {
+				edits.push_back({ source->insertPos, source->insertPos, newValues.str() });
+			} else {
+				// this section only exists implicitly (e.g. `[a][b]` without `[a]`), add a header for it
+				std::stringstream ss;
+				IniWriter writer(ss);
+				for (const std::string& category : path) {
+					writer.begin_section(category);
+				}
+				writer.write_raw(newValues.str());
+				appended += ss.str();
+			}
+		}
+	}
+
+	void Ini::adoptSource(const Ini& parsed) {
+		source = parsed.source ? std::make_unique<Source>(*parsed.source) : nullptr;
+
+		forEachElement(*this, [&parsed](const std::string& subKey, Ini& element) {
+			const Ini* found = parsed.find(subKey);
+			element.adoptSource(found != nullptr ? *found : Ini());
+		});
+	}
+
+	void Ini::save_incremental(const std::filesystem::path& path) {
+		std::string original;
+		{
+			std::ifstream file(path, std::ios::binary);
+			original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+		}
+
+		std::vector<std::string> categories;
+		std::vector<Edit> edits;
+		std::string appended;
+		collectEdits(categories, edits, appended);
+		if (!appended.empty()) {
+			edits.push_back({ original.size(), original.size(), std::move(appended) });
+		}
+		if (edits.empty()) {
+			return;
+		}
+
+		// insertions come before replacements at the same position
+		std::ranges::stable_sort(edits, [](const Edit& lhs, const Edit& rhs) {
+			return std::tie(lhs.begin, lhs.end) < std::tie(rhs.begin, rhs.end);
+		});
+
+		// the last line has no line break, add one before inserting behind it
+		if (!original.empty() && original.back() != '\n') {
+			auto last = std::ranges::find_if(edits, [&original](const Edit& edit) {
+				return edit.begin == original.size();
+			});
+			if (last != edits.end()) {
+				last->text.insert(0, 1, '\n');
+			}
+		}
+
+		std::string result;
+		result.reserve(original.size());
+		size_t pos = 0;
+		bool sameSize = true;
+		for (const Edit& edit : edits) {
+			result.append(original, pos, edit.begin - pos);
+			result.append(edit.text);
+			pos = edit.end;
+			sameSize = sameSize && edit.text.size() == edit.end - edit.begin;
+		}
+		result.append(original, pos);
+
+		{
+			std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+			if (!file.is_open()) {
+				throw std::runtime_error("Unable to open file for `save_incremental()`");
+			}
+
+			if (sameSize) {
+				for (const Edit& edit : edits) {
+					file.seekp(edit.begin);
+					file.write(edit.text.data(), edit.text.size());
+				}
+			} else {
+				const size_t firstChange = edits.front().begin;
+				file.seekp(firstChange);
+				file.write(result.data() + firstChange, result.size() - firstChange);
+			}
+		}
+		if (result.size() < original.size()) {
+			std::filesystem::resize_file(path, result.size());
+		}
+
+		// source positions changed, read them again from the new content
+		Ini parsed;
+		std::istringstream ss(result);
+		ss >> parsed;
+		adoptSource(parsed);
+	}
+
+	/**
+	 * An `Ini` that is changed at runtime, where every change is appended to a journal file instead of rewriting the whole file.
+	 * On construction the base file is read and the journal is replayed on top of it, `compact()` writes a new base file and clears the journal.
+	 *
+	 * Each change is one group of records, terminated by a `.` line. Records are `=[cat][subcat]key=value` to set a value,
+	 * `+[cat][subcat]key` to create an empty section and `-[cat][subcat]key` to erase an element. `\`, `[`, `]` and `=` in keys are escaped with a `\`, line breaks as `\n`.
+	 * Incomplete groups (e.g. after a crash while writing) are dropped when the journal is opened.
+	 * A change is written to the journal before it is applied, if writing fails `get()` still matches the journal.
+	 */
+	class IniJournal {
+	public:
+		// reference to an element, changes made through it are written to the journal
+		class Ref {
+			friend class IniJournal;
+
+		private:
+			IniJournal& journal;
+			std::vector<std::string> path;
+
+			Ref(IniJournal& new_journal, std::vector<std::string> new_path) :
+				journal(new_journal), path(std::move(new_path)) { }
+
+		public:
+			Ref operator[](const std::string& key) const {
+				std::vector<std::string> subPath = path;
+				subPath.push_back(key);
+				return Ref(journal, std::move(subPath));
+			}
+
+			template<typename T>
+			Ref& operator=(const T& val) {
+				journal.assign(path, val);
+				return *this;
+			}
+
+			void erase(const std::string& key) {
+				std::vector<std::string> subPath = path;
+				subPath.push_back(key);
+				journal.erase(subPath);
+			}
+
+			// throws `std::out_of_range` if the element doesn't exist
+			const Ini& get() const {
+				const Ini* element = &journal.ini;
+				for (const std::string& key : path) {
+					element = &element->at(key);
+				}
+				return *element;
+			}
+		};
+
+	private:
+		std::filesystem::path basePath;
+		std::filesystem::path journalPath;
+		std::ofstream journalStream;
+		Ini ini;
+		size_t records = 0;
+
+		static void appendPath(std::string& record, const std::vector<std::string>& path) {
+			for (size_t i = 0; i + 1 < path.size(); ++i) {
+				record += '[';
+				detail::appendPathSegment(record, path[i]);
+				record += ']';
+			}
+			detail::appendPathSegment(record, path.back());
+		}
+
+		static void appendLeaves(std::string& record, std::vector<std::string>& path, const Ini& element) {
+			if (element.isValue()) {
+				std::stringstream ss;
+				detail::writeEscaped(ss, element.value);
+				record += '=';
+				appendPath(record, path);
+				record += '=';
+				record += ss.str();
+				record += '\n';
+				return;
+			}
+			// an empty section has no leaves, it needs a record of its own
+			if (element.size() == 0) {
+				record += '+';
+				appendPath(record, path);
+				record += '\n';
+				return;
+			}
+			Ini::forEachElement(element, [&record, &path](const std::string& subKey, const Ini& subElement) {
+				path.push_back(subKey);
+				appendLeaves(record, path, subElement);
+				path.pop_back();
+			});
+		}
+
+		void write(std::string& record) {
+			record += ".\n";
+			journalStream.write(record.data(), record.size());
+			journalStream.flush();
+			if (!journalStream) {
+				throw std::runtime_error("Unable to write to journal");
+			}
+			++records;
+		}
+
+		// parent of the element at `path`, created if it doesn't exist
+		Ini& parentOf(const std::vector<std::string>& path) {
+			if (path.empty()) {
+				throw std::out_of_range("Changes have to reference an element below the root");
+			}
+			Ini* element = &ini;
+			for (size_t i = 0; i + 1 < path.size(); ++i) {
+				element = &element->operator[](path[i]);
+			}
+			return *element;
+		}
+
+		// same as `parentOf()`, but doesn't create anything
+		Ini* findParent(const std::vector<std::string>& path) {
+			Ini* element = &ini;
+			for (size_t i = 0; i + 1 < path.size(); ++i) {
+				if (!element->has(path[i])) {
+					return nullptr;
+				}
+				element = &element->at(path[i]);
+			}
+			return element;
+		}
+
+		/**
+		 * The new element is built on a copy of the current one, the tree is only changed after the record was written.
+		 * Objects are merged like with `Ini::operator=()`, the journal contains the resulting object.
+		 */
+		template<typename T>
+		void assign(std::vector<std::string> path, const T& val) {
+			if (path.empty()) {
+				throw std::out_of_range("Changes have to reference an element below the root");
+			}
+			const Ini* parent = findParent(path);
+			const Ini* current = parent != nullptr ? parent->find(path.back()) : nullptr;
+			Ini element = current != nullptr ? *current : Ini();
+			element = val;
+
+			std::string record;
+			if (element.isObject()) {
+				record += '-';
+				appendPath(record, path);
+				record += '\n';
+			}
+			appendLeaves(record, path, element);
+			write(record);
+
+			parentOf(path)[path.back()] = std::move(element);
+		}
+
+		// an empty `std::optional` erases the element
+		template<typename T>
+		void assign(std::vector<std::string> path, const std::optional<T>& val) {
+			if (val) {
+				assign(std::move(path), *val);
+			} else {
+				erase(path);
+			}
+		}
+
+		void erase(const std::vector<std::string>& path) {
+			std::string record = "-";
+			appendPath(record, path);
+			record += '\n';
+			write(record);
+
+			Ini* parent = findParent(path);
+			if (parent != nullptr && parent->isObject()) {
+				parent->erase(path.back());
+			}
+		}
+
+		void replay(std::string_view line) {
+			const char operation = line.front();
+			line.remove_prefix(1);
+
+			std::vector<std::string> path;
+			std::string segment;
+			while (line.starts_with('[')) {
+				line.remove_prefix(1);
+				if (!detail::readPathSegment(line, ']', segment)) {
+					return;
+				}
+				path.push_back(segment);
+			}
+			const bool hasValue = detail::readPathSegment(line, '=', segment);
+			path.push_back(segment);
+
+			if (operation == '=') {
+				if (!hasValue) {
+					return;
+				}
+				parentOf(path)[path.back()] = detail::decodeValue(line);
+			} else if (operation == '+') {
+				parentOf(path)[path.back()] = Ini(std::map<std::string, Ini>{});
+			} else if (operation == '-') {
+				Ini* parent = findParent(path);
+				if (parent != nullptr && parent->isObject()) {
+					parent->erase(path.back());
+				}
+			}
+		}
+
+	public:
+		/**
+		 * Reads `base` (if it exists) and replays `journal` on top of it.
+		 * When no journal path is given, `<base>.journal` is used.
+		 */
+		explicit IniJournal(const std::filesystem::path& base, const std::filesystem::path& journal = {}) :
+			basePath(base), journalPath(journal) {
+			if (journalPath.empty()) {
+				journalPath = basePath;
+				journalPath += ".journal";
+			}
+
+			{
+				// without a base file this still makes the root an object
+				std::ifstream baseStream(basePath);
+				baseStream >> ini;
+			}
+
+			size_t validSize = 0;
+			{
+				std::ifstream stream(journalPath, std::ios::binary);
+				std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+				std::vector<std::string_view> group;
+				size_t pos = 0;
+				while (pos < content.size()) {
+					const size_t end = content.find('\n', pos);
+					if (end == std::string::npos) {
+						break;
+					}
+					std::string_view line(content.data() + pos, end - pos);
+					pos = end + 1;
+
+					if (line == ".") {
+						for (std::string_view record : group) {
+							replay(record);
+						}
+						group.clear();
+						validSize = pos;
+						++records;
+					} else if (!line.empty()) {
+						group.push_back(line);
+					}
+				}
+			}
+
+			// drop incomplete groups, so new records don't get appended to them
+			if (std::filesystem::exists(journalPath) && std::filesystem::file_size(journalPath) != validSize) {
+				std::filesystem::resize_file(journalPath, validSize);
+			}
+			journalStream.open(journalPath, std::ios::binary | std::ios::app);
+			if (!journalStream.is_open()) {
+				throw std::runtime_error("Unable to open journal");
+			}
+		}
+
+		Ref operator[](const std::string& key) {
+			return Ref(*this, { key });
+		}
+
+		void erase(const std::string& key) {
+			erase(std::vector<std::string>{ key });
+		}
+
+		const Ini& get() const {
+			return ini;
+		}
+
+		// number of changes in the journal, can be used to decide when to call `compact()`
+		size_t journal_size() const {
+			return records;
+		}
+
+		/**
+		 * Writes the current state into the base file and clears the journal.
+		 * The base file is replaced atomically, if the journal can't be cleared afterwards, replaying it again results in the same state.
+		 */
+		void compact() {
+			std::filesystem::path tempPath = basePath;
+			tempPath += ".tmp";
+			{
+				std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+				stream << ini;
+				stream.flush();
+				if (!stream) {
+					throw std::runtime_error("Unable to write compacted file");
+				}
+			}
+			std::filesystem::rename(tempPath, basePath);
+
+			journalStream.close();
+			journalStream.open(journalPath, std::ios::binary | std::ios::trunc);
+			if (!journalStream.is_open()) {
+				throw std::runtime_error("Unable to open journal");
+			}
+			records = 0;
+		}
+	};
+
+	/**
+	 * Shares an `Ini` between threads, that is replaced as a whole (e.g. on reload).
+	 * Every published `Ini` is an immutable snapshot, readers keep it alive as long as they use it, even when a newer one was published.
+	 * `acquire()` loads the atomic shared pointer, which touches the reference count on every call.
+	 * Threads, that read repeatedly, use their own `Reader` instead. It only reloads the snapshot when the version changed,
+	 * so the common case is a single atomic load of a value, that is only written by `publish()`.
+	 */
+	class ConfigHandle {
+	private:
+		std::atomic<std::shared_ptr<const Ini>> current;
+		std::atomic<uint64_t> currentVersion = 0;
+		// keeps snapshots and versions in the same order with concurrent writers
+		std::mutex publishMutex;
+
+		static std::shared_ptr<const Ini> makeSnapshot(Ini&& ini) {
+			auto snapshot = std::make_shared<Ini>(std::move(ini));
+			// a snapshot is a root, even when `ini` was a sub element
+			snapshot->setParent(nullptr);
+			return snapshot;
+		}
+
+	public:
+		// caches the snapshot for a single thread
+		class Reader {
+		private:
+			const ConfigHandle& handle;
+			std::shared_ptr<const Ini> snapshot;
+			uint64_t version;
+
+		public:
+			explicit Reader(const ConfigHandle& new_handle) :
+				handle(new_handle), version(new_handle.currentVersion.load(std::memory_order_acquire)) {
+				snapshot = handle.current.load(std::memory_order_acquire);
+			}
+
+			// the latest snapshot, valid until the next call of `get()`
+			const Ini& get() {
+				const uint64_t latest = handle.currentVersion.load(std::memory_order_acquire);
+				if (latest != version) {
+					// the snapshot is at least as new as `latest`, a newer one is loaded again next time
+					snapshot = handle.current.load(std::memory_order_acquire);
+					version = latest;
+				}
+				return *snapshot;
+			}
+
+			const Ini& operator*() {
+				return get();
+			}
+
+			const Ini* operator->() {
+				return &get();
+			}
+		};
+
+		// starts with an empty object, like a parsed empty file
+		ConfigHandle() :
+			current(makeSnapshot(Ini(std::map<std::string, Ini>{}))) { }
+
+		explicit ConfigHandle(Ini ini) :
+			current(makeSnapshot(std::move(ini))) { }
+
+		ConfigHandle(const ConfigHandle&) = delete;
+		ConfigHandle& operator=(const ConfigHandle&) = delete;
+
+		// the latest snapshot, it stays valid as long as the pointer is kept
+		std::shared_ptr<const Ini> acquire() const {
+			return current.load(std::memory_order_acquire);
+		}
+
+		Reader reader() const {
+			return Reader(*this);
+		}
+
+		// replaces the snapshot, readers of the old one can still finish with it
+		void publish(Ini ini) {
+			std::shared_ptr<const Ini> snapshot = makeSnapshot(std::move(ini));
+
+			std::lock_guard lock(publishMutex);
+			current.store(std::move(snapshot), std::memory_order_release);
+			currentVersion.fetch_add(1, std::memory_order_release);
+		}
+
+		// incremented by every `publish()`
+		uint64_t version() const {
+			return currentVersion.load(std::memory_order_acquire);
+		}
+	};
+
+#if defined(__linux__) || defined(_WIN32)
+	/**
+	 * Watches an ini file with inotify (Linux) or `ReadDirectoryChangesW()` (Windows) and reloads it after it was changed.
+	 * Bursts of events (e.g. an editor writing the file in several steps) are collected until there was no event for `debounce`.
+	 * The directory is watched instead of the file, so files replaced by renaming (like most editors save) are still found.
+	 * The file is only parsed again, when its content changed. Callbacks are called on the watcher thread,
+	 * only for the elements in the `diff()` of the old and new content. They are called without holding a lock,
+	 * so they can register further callbacks, these get the changes of the next reload.
+	 * Paths are in the journal format `[cat][subcat]key` with escaped keys, like in `diff()`. A callback for a section (e.g. `[cat]`) gets the changes of all elements below it,
+	 * a callback for an empty path gets every change. Added or removed sections are a single change with the section path.
+	 */
+	class IniWatcher {
+	public:
+		// `value` is the new element at `path`, `nullptr` when it was removed
+		using Callback = std::function<void(const std::string& path, const Ini* value)>;
+
+	private:
+		std::filesystem::path filePath;
+		std::chrono::milliseconds debounceTime;
+		ConfigHandle config;
+		std::string content;
+
+		// copied before they are called, so the lock isn't held during the callbacks
+		using CallbackList = std::vector<std::pair<std::string, Callback>>;
+		std::mutex callbackMutex;
+		CallbackList callbacks;
+
+#ifdef _WIN32
+		HANDLE directory = INVALID_HANDLE_VALUE;
+		HANDLE directoryEvent = nullptr;
+		OVERLAPPED overlapped{};
+		alignas(FILE_NOTIFY_INFORMATION) char eventBuffer[4096];
+#else
+		int inotifyFd = -1;
+#endif
+		std::atomic<bool> stopping = false;
+		std::thread thread;
+
+		// the content is kept, to skip parsing when the file was written without changes
+		bool readFile() {
+			std::ifstream file(filePath, std::ios::binary);
+			if (!file) {
+				return false;
+			}
+			std::string newContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			if (newContent == content) {
+				return false;
+			}
+			content = std::move(newContent);
+			return true;
+		}
+
+		Ini parseContent() const {
+			Ini ini;
+			Ini::Builder builder(ini);
+			detail::tokenize(std::string_view(content), builder);
+			return ini;
+		}
+
+		// element at `path` in the journal format, `nullptr` if it doesn't exist
+		static const Ini* findElement(const Ini& root, std::string_view path) {
+			const Ini* element = &root;
+			std::string segment;
+			while (element != nullptr && path.starts_with('[')) {
+				path.remove_prefix(1);
+				if (!detail::readPathSegment(path, ']', segment)) {
+					return nullptr;
+				}
+				element = element->find(segment);
+			}
+			if (element != nullptr && !path.empty()) {
+				// an escaped key has no unescaped `=`, so the rest of the path is read
+				detail::readPathSegment(path, '=', segment);
+				element = element->find(segment);
+			}
+			return element;
+		}
+
+		static void notify(const CallbackList& callbacks, const std::string& changed, const Ini* value) {
+			for (const auto& [prefix, callback] : callbacks) {
+				// a change of the whole root, a change below `prefix` or a whole section containing it
+				if (changed.empty()
+					|| (changed.starts_with(prefix) && (changed == prefix || prefix.empty() || detail::isSectionPath(prefix)))
+					|| (detail::isSectionPath(changed) && prefix.starts_with(changed))) {
+					callback(changed, value);
+				}
+			}
+		}
+
+		void reload() {
+			if (!readFile()) {
+				return;
+			}
+
+			const std::shared_ptr<const Ini> oldIni = config.acquire();
+			config.publish(parseContent());
+			const std::shared_ptr<const Ini> newIni = config.acquire();
+
+			CallbackList currentCallbacks;
+			{
+				std::lock_guard lock(callbackMutex);
+				currentCallbacks = callbacks;
+			}
+			if (currentCallbacks.empty()) {
+				return;
+			}
+			const IniDiff changes = diff(*oldIni, *newIni);
+			for (const std::string& path : changes.removed) {
+				notify(currentCallbacks, path, nullptr);
+			}
+			for (const std::string& path : changes.added) {
+				notify(currentCallbacks, path, findElement(*newIni, path));
+			}
+			for (const std::string& path : changes.changed) {
+				notify(currentCallbacks, path, findElement(*newIni, path));
+			}
+		}
+
+#ifdef _WIN32
+		// starts the next asynchronous read of directory changes into `eventBuffer`
+		bool watchDirectory() {
+			overlapped = {};
+			overlapped.hEvent = directoryEvent;
+			return ReadDirectoryChangesW(directory, eventBuffer, sizeof(eventBuffer), FALSE,
+				FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE, nullptr, &overlapped, nullptr) != 0;
+		}
+
+		// true if an event for the file was read within `timeout` milliseconds
+		bool waitForEvents(int timeout) {
+			if (WaitForSingleObject(directoryEvent, static_cast<DWORD>(timeout)) != WAIT_OBJECT_0) {
+				return false;
+			}
+			bool found = false;
+			DWORD length = 0;
+			if (GetOverlappedResult(directory, &overlapped, &length, FALSE)) {
+				// an empty result means, that the buffer overflowed and the events are lost
+				found = length == 0;
+				const std::wstring fileName = filePath.filename().wstring();
+				for (DWORD pos = 0; pos < length;) {
+					const auto* event = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(eventBuffer + pos);
+					if (std::wstring_view(event->FileName, event->FileNameLength / sizeof(WCHAR)) == fileName) {
+						found = true;
+					}
+					if (event->NextEntryOffset == 0) {
+						break;
+					}
+					pos += event->NextEntryOffset;
+				}
+			}
+			ResetEvent(directoryEvent);
+			watchDirectory();
+			return found;
+		}
+
+		void closeWatch() {
+			if (directory != INVALID_HANDLE_VALUE) {
+				// waits for the cancelled read, it writes into `eventBuffer`
+				if (CancelIoEx(directory, &overlapped)) {
+					DWORD length = 0;
+					GetOverlappedResult(directory, &overlapped, &length, TRUE);
+				}
+				CloseHandle(directory);
+			}
+			if (directoryEvent != nullptr) {
+				CloseHandle(directoryEvent);
+			}
+		}
+#else
+		// true if an event for the file was read within `timeout` milliseconds
+		bool waitForEvents(int timeout) {
+			pollfd fd{ inotifyFd, POLLIN, 0 };
+			if (poll(&fd, 1, timeout) <= 0) {
+				return false;
+			}
+			alignas(inotify_event) char buffer[4096];
+			bool found = false;
+			ssize_t length;
+			while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+				for (ssize_t pos = 0; pos < length;) {
+					const auto* event = reinterpret_cast<const inotify_event*>(buffer + pos);
+					if (event->len > 0 && filePath.filename() == event->name) {
+						found = true;
+					}
+					pos += sizeof(inotify_event) + event->len;
+				}
+			}
+			return found;
+		}
+
+		void closeWatch() {
+			close(inotifyFd);
+		}
+#endif
+
+		void run() {
+			// wakes up regularly to check `stopping`, also the interval in which bursts are collected
+			const int timeout = static_cast<int>(std::clamp<std::chrono::milliseconds::rep>(debounceTime.count(), 1, 100));
+			std::optional<std::chrono::steady_clock::time_point> lastEvent;
+			while (!stopping.load()) {
+				if (waitForEvents(timeout)) {
+					lastEvent = std::chrono::steady_clock::now();
+				}
+				if (lastEvent && std::chrono::steady_clock::now() - *lastEvent >= debounceTime) {
+					lastEvent.reset();
+					reload();
+				}
+			}
+		}
+
+	public:
+		/**
+		 * Reads `path` and starts watching it.
+		 * Throws `std::runtime_error` if the directory of the file can't be watched.
+		 */
+		explicit IniWatcher(const std::filesystem::path& path, std::chrono::milliseconds debounce = std::chrono::milliseconds(50)) :
+			filePath(std::filesystem::absolute(path)), debounceTime(debounce) {
+			if (readFile()) {
+				config.publish(parseContent());
+			}
+
+#ifdef _WIN32
+			directory = CreateFileW(filePath.parent_path().c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+				nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+			directoryEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+			if (directory == INVALID_HANDLE_VALUE || directoryEvent == nullptr || !watchDirectory()) {
+				closeWatch();
+				throw std::runtime_error("Unable to watch directory of the ini file");
+			}
+#else
+			inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+			if (inotifyFd < 0) {
+				throw std::runtime_error("Unable to initialize inotify");
+			}
+			if (inotify_add_watch(inotifyFd, filePath.parent_path().c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0) {
+				closeWatch();
+				throw std::runtime_error("Unable to watch directory of the ini file");
+			}
+#endif
+
+			thread = std::thread(&IniWatcher::run, this);
+		}
+
+		IniWatcher(const IniWatcher&) = delete;
+		IniWatcher& operator=(const IniWatcher&) = delete;
+
+		~IniWatcher() {
+			stopping = true;
+			thread.join();
+			closeWatch();
+		}
+
+		// the latest content of the file
+		const ConfigHandle& handle() const {
+			return config;
+		}
+
+		// `callback` is called for every changed element at or below `path`
+		void on_change(const std::string& path, Callback callback) {
+			std::lock_guard lock(callbackMutex);
+			callbacks.emplace_back(path, std::move(callback));
+		}
+	};
+#endif
+
+	/**
+	 * Stacks several `Ini` (e.g. defaults, site and host config) without merging them.
+	 * Lookups check the layers from the top (last pushed) to the bottom, values of higher layers hide the ones below.
+	 * Sections of all layers are combined, a value hides sections of lower layers and the other way around.
+	 * `flatten()` merges all layers into a single `Ini`, sections read through a `View` are merged once as well.
+	 * The merged results are kept until a layer is added or replaced.
+	 * Const members can be called from several threads at once. Adding or replacing a layer must not run concurrently
+	 * with anything else, views and references returned by `at()` are only valid until the layers are changed.
+	 */
+	class IniOverlay {
+	public:
+		// the element at one path in all layers
+		class View {
+			friend class IniOverlay;
+
+		private:
+			const IniOverlay* overlay;
+			// top layer first, either a single value or only objects and arrays
+			std::vector<const Ini*> elements;
+
+			View(const IniOverlay* new_overlay, std::vector<const Ini*> new_elements) :
+				overlay(new_overlay), elements(std::move(new_elements)) { }
+
+		public:
+			bool isValue() const {
+				return elements.size() == 1 && elements.front()->isValue();
+			}
+
+			bool has(const std::string& key) const {
+				return std::ranges::any_of(elements, [&key](const Ini* element) {
+					return element->has(key);
+				});
+			}
+
+			// throws `std::out_of_range` if no layer has `key`
+			View at(const std::string& key) const {
+				std::vector<const Ini*> found;
+				for (const Ini* element : elements) {
+					const Ini* subElement = element->find(key);
+					if (subElement == nullptr) {
+						continue;
+					}
+					if (subElement->isValue()) {
+						if (found.empty()) {
+							found.push_back(subElement);
+						}
+						break;
+					}
+					found.push_back(subElement);
+				}
+				if (found.empty()) {
+					throw std::out_of_range("Called `at()` with a key, that no layer contains");
+				}
+				return View(overlay, std::move(found));
+			}
+
+			View operator[](const std::string& key) const {
+				return at(key);
+			}
+
+			// values are read from the top layer, sections are merged once per layer change
+			template<typename T>
+			void get_to(T& val) const {
+				if (elements.size() == 1) {
+					elements.front()->get_to(val);
+				} else {
+					overlay->flattenSection(elements)->get_to(val);
+				}
+			}
+
+			template<typename T>
+			T get() const {
+				T val = {};
+				get_to(val);
+				return val;
+			}
+
+			// merges all layers of this element into a new `Ini`
+			Ini flatten() const {
+				Ini result;
+				if (isValue()) {
+					result = elements.front()->get<std::string>();
+					return result;
+				}
+				for (const Ini* element : elements | std::views::reverse) {
+					merge(result, *element);
+				}
+				return result;
+			}
+		};
+
+	private:
+		// bottom layer first
+		std::vector<std::shared_ptr<const Ini>> layers;
+		// guards the merged results, which are filled by const members
+		mutable std::mutex flattenMutex;
+		mutable std::shared_ptr<const Ini> flattened;
+		// merged sections of `View::get_to()`, keyed by the elements of the view
+		mutable std::map<std::vector<const Ini*>, std::shared_ptr<const Ini>> flattenedSections;
+
+		void layersChanged() {
+			flattened.reset();
+			flattenedSections.clear();
+		}
+
+		std::shared_ptr<const Ini> flattenSection(const std::vector<const Ini*>& elements) const {
+			std::lock_guard lock(flattenMutex);
+			auto [found, inserted] = flattenedSections.try_emplace(elements);
+			if (inserted) {
+				found->second = std::make_shared<Ini>(View(this, elements).flatten());
+			}
+			return found->second;
+		}
+
+		// copies the elements of `source` into `target`, replacing values and merging sections
+		static void merge(Ini& target, const Ini& source) {
+			source.for_each([&target](const std::string& subKey, const Ini& element) {
+				if (element.isValue()) {
+					target[subKey] = element.get<std::string>();
+				} else {
+					Ini& subTarget = target[subKey];
+					if (subTarget.isValue()) {
+						target.erase(subKey);
+					}
+					merge(target[subKey], element);
+				}
+			});
+		}
+
+	public:
+		IniOverlay() = default;
+
+		// `new_layers` are ordered from the bottom (e.g. defaults) to the top (e.g. host)
+		explicit IniOverlay(std::vector<std::shared_ptr<const Ini>> new_layers) :
+			layers(std::move(new_layers)) { }
+
+		// adds a layer on top of the others, returns its index
+		size_t push_layer(std::shared_ptr<const Ini> layer) {
+			std::lock_guard lock(flattenMutex);
+			layers.push_back(std::move(layer));
+			layersChanged();
+			return layers.size() - 1;
+		}
+
+		// replaces a single layer, the others are not touched
+		void set_layer(size_t index, std::shared_ptr<const Ini> layer) {
+			std::lock_guard lock(flattenMutex);
+			layers.at(index) = std::move(layer);
+			layersChanged();
+		}
+
+		const Ini& layer(size_t index) const {
+			return *layers.at(index);
+		}
+
+		size_t size() const {
+			return layers.size();
+		}
+
+		View root() const {
+			std::vector<const Ini*> elements;
+			elements.reserve(layers.size());
+			for (const auto& layer : layers | std::views::reverse) {
+				elements.push_back(layer.get());
+			}
+			return View(this, std::move(elements));
+		}
+
+		bool has(const std::string& key) const {
+			return std::ranges::any_of(layers, [&key](const std::shared_ptr<const Ini>& layer) {
+				return layer->has(key);
+			});
+		}
+
+		View at(const std::string& key) const {
+			return root().at(key);
+		}
+
+		View operator[](const std::string& key) const {
+			return at(key);
+		}
+
+		template<typename T>
+		T get() const {
+			return flatten()->get<T>();
+		}
+
+		// all layers merged into one, kept until a layer is replaced
+		std::shared_ptr<const Ini> flatten() const {
+			std::lock_guard lock(flattenMutex);
+			if (!flattened) {
+				flattened = std::make_shared<Ini>(root().flatten());
+			}
+			return flattened;
+		}
+	};
+
+	struct LoadOptions {
+		// only files with this extension are read, all files if empty
+		std::string extension = ".ini";
+		// 0 uses all available cores
+		size_t threads = 0;
+	};
+
+	/**
+	 * Reads all files of the directory `path` (not its sub directories) on `options.threads` threads.
+	 * The result is keyed by file name. Throws `std::filesystem::filesystem_error` if the directory can't be read
+	 * and `std::runtime_error` if a file can't be opened.
+	 */
+	std::map<std::string, Ini> load_directory_files(const std::filesystem::path& path, const LoadOptions& options = {}) {
+		std::vector<std::filesystem::path> files;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path)) {
+			if (entry.is_regular_file() && (options.extension.empty() || entry.path().extension() == options.extension)) {
+				files.push_back(entry.path());
+			}
+		}
+
+		// parsed in place, so the parents of the sub elements stay valid
+		std::map<std::string, Ini> result;
+		std::vector<Ini*> parsed;
+		parsed.reserve(files.size());
+		for (const std::filesystem::path& file : files) {
+			parsed.push_back(&result[file.filename().string()]);
+		}
+
+		detail::parallelFor(files.size(), options.threads, [&files, &parsed](size_t i) {
+			std::ifstream file(files[i], std::ios::binary);
+			if (!file) {
+				throw std::runtime_error(std::format("Unable to open `{}` in `load_directory()`", files[i].string()));
+			}
+			file >> *parsed[i];
+		});
+		return result;
+	}
+
+	/**
+	 * Reads all files of `path` like `load_directory_files()` and merges them in the order of their file names.
+	 * Values of later files replace the ones of earlier files (e.g. `90-host.ini` overrides `10-defaults.ini`).
+	 */
+	Ini load_directory(const std::filesystem::path& path, const LoadOptions& options = {}) {
+		Ini result(std::map<std::string, Ini>{});
+		for (auto& ini : load_directory_files(path, options) | std::views::values) {
+			result.merge(std::move(ini));
+		}
+		return result;
+	}
+
+	struct AsyncLoadOptions {
+		// size of the blocks read from the file
+		size_t blockSize = 1 << 20;
+		// blocks read ahead of the parser
+		size_t maxBlocks = 4;
+		/**
+		 * Resumes the coroutine awaiting `async_load()` after the load, e.g. by posting it to an event loop.
+		 * Without one it is resumed on a new thread, so it never blocks a thread of the load executor.
+		 */
+		std::function<void(std::coroutine_handle<>)> resume;
+	};
+}
+
+namespace modernIni::detail {
+	/**
+	 * Small thread pool shared by all asynchronous loads, the number of threads is bounded and further tasks are queued.
+	 * The threads are started with the first task and joined after the queue ran empty when the program exits.
+	 */
+	class LoadExecutor {
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::function<void()>> tasks;
+		std::vector<std::thread> workers;
+		size_t maxWorkers;
+		size_t idle = 0;
+		bool stopping = false;
+
+		void run() {
+			std::unique_lock lock(mutex);
+			while (true) {
+				++idle;
+				condition.wait(lock, [this] {
+					return !tasks.empty() || stopping;
+				});
+				--idle;
+				if (tasks.empty()) {
+					return;
+				}
+				auto task = std::move(tasks.front());
+				tasks.pop_front();
+
+				lock.unlock();
+				task();
+				lock.lock();
+			}
+		}
+
+	public:
+		explicit LoadExecutor(size_t new_max_workers) :
+			maxWorkers(std::max<size_t>(new_max_workers, 1)) { }
+
+		LoadExecutor(const LoadExecutor&) = delete;
+		LoadExecutor& operator=(const LoadExecutor&) = delete;
+
+		~LoadExecutor() {
+			{
+				std::lock_guard lock(mutex);
+				stopping = true;
+			}
+			condition.notify_all();
+			for (std::thread& worker : workers) {
+				worker.join();
+			}
+		}
+
+		static LoadExecutor& shared() {
+			static LoadExecutor executor(std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 4));
+			return executor;
+		}
+
+		// `task` must not throw, it runs as soon as a thread is free
+		void post(std::function<void()> task) {
+			std::lock_guard lock(mutex);
+			tasks.push_back(std::move(task));
+			if (idle < tasks.size() && workers.size() < maxWorkers) {
+				workers.emplace_back(&LoadExecutor::run, this);
+			}
+			condition.notify_one();
+		}
+
+		/**
+		 * Only posts `task`, if a thread can start it right away. Tasks running on the executor use this for helpers
+		 * they wait for, a queued helper could wait for the very thread that waits for it.
+		 */
+		bool try_post(std::function<void()>& task) {
+			std::lock_guard lock(mutex);
+			if (idle <= tasks.size() && workers.size() >= maxWorkers) {
+				return false;
+			}
+			tasks.push_back(std::move(task));
+			if (idle < tasks.size()) {
+				workers.emplace_back(&LoadExecutor::run, this);
+			}
+			condition.notify_one();
+			return true;
+		}
+	};
+
+	/**
+	 * Reads `path` in blocks on a thread of the `LoadExecutor` while the blocks already read are parsed.
+	 * Files that fit into a single block, or when no thread is free, are read and parsed at once.
+	 */
+	Ini loadPipelined(const std::filesystem::path& path, const AsyncLoadOptions& options) {
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			throw std::runtime_error("Unable to open file for `async_load()`");
+		}
+
+		Ini ini;
+		std::error_code sizeError;
+		const auto size = std::filesystem::file_size(path, sizeError);
+		if (!sizeError && size <= options.blockSize) {
+			std::string content(static_cast<size_t>(size), '\0');
+			file.read(content.data(), content.size());
+			content.resize(static_cast<size_t>(file.gcount()));
+			std::istringstream stream(std::move(content));
+			stream >> ini;
+			return ini;
+		}
+
+		BlockStreamBuf buffer(std::max<size_t>(options.maxBlocks, 1));
+		bool readError = false;
+		std::promise<void> readerDone;
+		std::function<void()> reader = [&file, &buffer, &readError, &options, &readerDone] {
+			try {
+				while (file) {
+					std::string block(options.blockSize, '\0');
+					file.read(block.data(), block.size());
+					block.resize(static_cast<size_t>(file.gcount()));
+					if (block.empty() || !buffer.push(std::move(block))) {
+						break;
+					}
+				}
+				readError = file.bad();
+			} catch (...) {
+				readError = true;
+			}
+			buffer.finish();
+			readerDone.set_value();
+		};
+
+		if (!LoadExecutor::shared().try_post(reader)) {
+			file >> ini;
+			if (file.bad()) {
+				throw std::runtime_error("Unable to read file for `async_load()`");
+			}
+			return ini;
+		}
+
+		try {
+			std::istream stream(&buffer);
+			stream >> ini;
+		} catch (...) {
+			buffer.cancel();
+			readerDone.get_future().wait();
+			throw;
+		}
+		readerDone.get_future().wait();
+
+		if (readError) {
+			throw std::runtime_error("Unable to read file for `async_load()`");
+		}
+		return ini;
+	}
+}
+
+export namespace modernIni {
+	/**
+	 * Loads `path` on the shared load executor, the reading of the next block overlaps with parsing the previous one.
+	 * Errors (e.g. a missing file) are thrown by `std::future::get()`.
+	 */
+	std::future<Ini> async_load_future(const std::filesystem::path& path, const AsyncLoadOptions& options = {}) {
+		auto promise = std::make_shared<std::promise<Ini>>();
+		auto future = promise->get_future();
+		detail::LoadExecutor::shared().post([promise, path, options] {
+			try {
+				promise->set_value(detail::loadPipelined(path, options));
+			} catch (...) {
+				promise->set_exception(std::current_exception());
+			}
+		});
+		return future;
+	}
+
+	/**
+	 * Awaitable returned by `async_load()`. The coroutine is suspended while the file is loaded on the shared load executor
+	 * and resumed through `AsyncLoadOptions::resume` afterwards, never on the thread of the executor itself.
+	 */
+	class AsyncLoad {
+	private:
+		std::filesystem::path path;
+		AsyncLoadOptions options;
+		std::optional<Ini> result;
+		std::exception_ptr error;
+
+	public:
+		AsyncLoad(std::filesystem::path new_path, const AsyncLoadOptions& new_options) :
+			path(std::move(new_path)), options(new_options) { }
+
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			// the awaitable lives in the suspended coroutine frame until it is resumed
+			detail::LoadExecutor::shared().post([this, handle] {
+				try {
+					result.emplace(detail::loadPipelined(path, options));
+				} catch (...) {
+					error = std::current_exception();
+				}
+				// the coroutine may block, that would keep the thread from further loads,
+				// `resume` is moved out of the frame first, resuming may destroy it
+				const auto resume = std::move(options.resume);
+				if (resume) {
+					resume(handle);
+				} else {
+					std::thread([handle] {
+						handle.resume();
+					}).detach();
+				}
+			});
+		}
+
+		Ini await_resume() {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+			return std::move(*result);
+		}
+	};
+
+	// `co_await async_load(path)` loads the file without blocking the awaiting thread
+	AsyncLoad async_load(const std::filesystem::path& path, const AsyncLoadOptions& options = {}) {
+		return AsyncLoad(path, options);
+	}
+
+	/**
+	 * Reads all fields of `obj` in a single pass over the sub elements of `ini`.
+	 * Both are sorted by name, so they are matched like in a merge, keys without a field are ignored.
+	 * When the table is `required`, a missing field (or `ini` not being an object) throws `std::out_of_range`, like `at()` does.
+	 * Otherwise fields that can't be read (e.g. a list with an invalid item) are skipped and might be read partially,
+	 * so the `noexcept` `from_ini()` of the `*_NO_EXCEPT` macros never throws.
+	 */
+	void from_ini_fields(void* obj, const Ini& ini, const FieldTable& table) {
+		if (!ini.isObject()) {
+			if (table.required) {
+				throw std::out_of_range("Called `from_ini()` on non-object");
+			}
+			return;
+		}
+
+		const std::span<const FieldBinding> fields = table.fields;
+		size_t fieldIndex = 0;
+		size_t found = 0;
+		for (const auto& [key, element] : ini.subElements) {
+			while (fieldIndex < fields.size() && fields[fieldIndex].name < key) {
+				++fieldIndex;
+			}
+			if (fieldIndex == fields.size()) {
+				break;
+			}
+			if (fields[fieldIndex].name == key) {
+				if (table.required) {
+					fields[fieldIndex].bind(obj, element);
+				} else {
+					try {
+						fields[fieldIndex].bind(obj, element);
+					} catch (...) {
+						// skipped like a missing field
+					}
+				}
+				++found;
+				++fieldIndex;
+			}
+		}
+
+		if (table.required && found != fields.size()) {
+			throw std::out_of_range("Missing key in `from_ini()`");
+		}
+	}
+
+	// assigns all fields of `obj` to the sub elements of `ini`, the reverse of `from_ini_fields()`
+	void to_ini_fields(const void* obj, Ini& ini, const FieldTable& table) {
+		for (const FieldBinding& field : table.declared) {
+			field.store(obj, ini[std::string(field.name)]);
+		}
+	}
+
+	// writes the values of `obj` before its sections, so the values stay in the section of `obj`
+	void to_ini_fields(const void* obj, IniWriter& writer, const FieldTable& table) {
+		for (const FieldBinding& field : table.declared) {
+			field.write(obj, writer, field.name, false);
+		}
+		for (const FieldBinding& field : table.declared) {
+			field.write(obj, writer, field.name, true);
+		}
+	}
+}
+
+namespace modernIni::detail {
+	// enums with a custom `from_ini()`, it can't report errors
+	template<HasFromIni T>
+	requires std::is_enum_v<T> && (!HasEnumNames<T>)
+	bool parseValue(std::string_view value, T& val) {
+		Ini(std::string(value)).get_to(val);
+		return true;
+	}
+
+	template<typename T>
+	bool parseValue(std::string_view value, std::optional<T>& val) {
+		T newVal = {};
+		const bool parsed = parseValue(value, newVal);
+		val = std::move(newVal);
+		return parsed;
+	}
+}
+
+export namespace modernIni {
+	template<typename T>
+	bool Ini::try_get_to(const std::string& key, T& val, IniError& error) const {
+		const Ini* element = find(key);
+		if (element == nullptr) {
+			error = IniError::MissingKey;
+			return false;
+		}
+
+		if constexpr (detail::isIniValue<T>) {
+			if (!element->isValue()) {
+				error = IniError::WrongType;
+				return false;
+			}
+			if (!detail::parseValue(element->value, val)) {
+				error = IniError::ParseError;
+				return false;
+			}
+		} else {
+			if (element->isValue()) {
+				error = IniError::WrongType;
+				return false;
+			}
+			element->get_to(val);
+		}
+		return true;
+	}
+}
+
+namespace modernIni::detail {
+	/**
+	 * Handler for `tokenize()`, that writes the values directly into the members of a struct, without building an `Ini` tree.
+	 * Sections select the nested structs. Members that are neither a single value nor a struct with a `FieldTable` (e.g. containers)
+	 * are collected into a small `Ini` each and read with their `from_ini()` in `finish()`.
+	 * Missing fields are checked in `finish()` as well, with the same rules as `from_ini_fields()`.
+	 */
+	class StructParser {
+	private:
+		enum class State : uint8_t {
+			Missing,
+			Value,
+			Object
+		};
+
+		// a struct that was reached by the input
+		struct Frame {
+			void* obj = nullptr;
+			FieldTable table;
+			std::vector<State> states;
+			// members that are read with their `from_ini()`, by field index
+			std::map<size_t, Ini> scratch;
+		};
+
+		// a struct and its first member have the same address, so the table is part of the key
+		std::map<std::pair<void*, const FieldBinding*>, Frame> frames;
+		Frame* root;
+		// the current section is either a struct or a node of a scratch `Ini`, both are null for ignored sections
+		Frame* frame;
+		Ini* node = nullptr;
+
+		Frame& frameFor(void* obj, const FieldTable& table) {
+			auto [found, inserted] = frames.try_emplace({ obj, table.fields.data() });
+			Frame& newFrame = found->second;
+			if (inserted) {
+				newFrame.obj = obj;
+				newFrame.table = table;
+				newFrame.states.assign(table.fields.size(), State::Missing);
+			}
+			return newFrame;
+		}
+
+		// index of the field `name`, or the number of fields if there is none
+		static size_t findField(const FieldTable& table, std::string_view name) {
+			auto found = std::ranges::lower_bound(table.fields, name, {}, &FieldBinding::name);
+			if (found == table.fields.end() || found->name != name) {
+				return table.fields.size();
+			}
+			return found - table.fields.begin();
+		}
+
+	public:
+		StructParser(void* obj, const FieldTable& table) :
+			root(&frameFor(obj, table)), frame(root) { }
+
+		void section(const std::vector<std::string_view>& categories, const LineSource&) {
+			frame = root;
+			node = nullptr;
+
+			for (std::string_view category : categories) {
+				if (node != nullptr) {
+					node = &node->operator[](std::string(category));
+					node->type = Type::Object;
+					continue;
+				}
+				if (frame == nullptr) {
+					break;
+				}
+
+				const size_t index = findField(frame->table, category);
+				if (index == frame->table.fields.size()) {
+					frame = nullptr;
+					break;
+				}
+				const FieldBinding& field = frame->table.fields[index];
+				frame->states[index] = State::Object;
+				if (field.table != nullptr) {
+					frame = &frameFor(field.member(frame->obj), field.table());
+				} else if (field.assign == nullptr) {
+					node = &frame->scratch[index];
+					node->type = Type::Object;
+					frame = nullptr;
+				} else {
+					// a single value has no sub elements
+					frame = nullptr;
+				}
+			}
+		}
+
+		void value(std::string_view key, std::string_view value, const LineSource&) {
+			if (node != nullptr) {
+				std::string name(key);
+				node->subElements.try_emplace(name, name, std::string(value), node);
+				return;
+			}
+			if (frame == nullptr) {
+				return;
+			}
+
+			// the first occurrence of a key wins, like in `operator>>`
+			const size_t index = findField(frame->table, key);
+			if (index == frame->table.fields.size() || frame->states[index] != State::Missing) {
+				return;
+			}
+			frame->states[index] = State::Value;
+
+			const FieldBinding& field = frame->table.fields[index];
+			if (field.assign != nullptr) {
+				field.assign(field.member(frame->obj), value);
+			} else if (field.table == nullptr) {
+				frame->scratch[index].value = value;
+			}
+		}
+
+		void finish() {
+			for (Frame& current : frames | std::views::values) {
+				for (auto& [index, ini] : current.scratch) {
+					if (current.table.required) {
+						current.table.fields[index].bind(current.obj, ini);
+					} else {
+						try {
+							current.table.fields[index].bind(current.obj, ini);
+						} catch (...) {
+							// skipped like in `from_ini_fields()`
+						}
+					}
+				}
+
+				for (size_t i = 0; i < current.states.size(); ++i) {
+					const FieldBinding& field = current.table.fields[i];
+					if (current.states[i] == State::Missing && current.table.required) {
+						throw std::out_of_range("Missing key in `from_ini()`");
+					}
+					if (current.states[i] == State::Value && field.table != nullptr && field.table().required) {
+						throw std::out_of_range("Called `from_ini()` on non-object");
+					}
+				}
+			}
+		}
+	};
+
+	/**
+	 * Splits a list value at `separator` and converts every item, spaces around the items are ignored.
+	 * Resizable containers reserve the number of items once and get them appended, so proxies like `std::vector<bool>` work.
+	 * Fixed ones only get as many items as fit into them.
+	 * Throws `std::invalid_argument`, if an item can't be converted completely.
+	 */
+	template<typename Container>
+	void parseList(std::string_view value, char separator, Container& obj) {
+		using Item = std::ranges::range_value_t<Container>;
+		constexpr bool resizable = requires(Item item) { obj.push_back(std::move(item)); };
+		if constexpr (resizable) {
+			obj.clear();
+		}
+		if (value.empty()) {
+			return;
+		}
+
+		// both `std::count()` and `find()` are vectorized by the standard library (`find()` uses `memchr()`)
+		size_t size = std::count(value.begin(), value.end(), separator) + 1;
+		if constexpr (resizable) {
+			if constexpr (requires { obj.reserve(size); }) {
+				obj.reserve(size);
+			}
+		} else {
+			size = std::min(size, std::size(obj));
+		}
+
+		size_t pos = 0;
+		for (size_t i = 0; i < size; ++i) {
+			size_t end = value.find(separator, pos);
+			if (end == std::string_view::npos) {
+				end = value.size();
+			}
+
+			std::string_view item = value.substr(pos, end - pos);
+			const size_t first = item.find_first_not_of(' ');
+			item = first == std::string_view::npos ? std::string_view() : item.substr(first, item.find_last_not_of(' ') + 1 - first);
+			bool parsed;
+			if constexpr (resizable) {
+				Item parsedItem{};
+				parsed = parseValue(item, parsedItem);
+				obj.push_back(std::move(parsedItem));
+			} else {
+				parsed = parseValue(item, obj[i]);
+			}
+			if (!parsed) {
+				throw std::invalid_argument(std::format("Unable to convert the list item `{}`", item));
+			}
+
+			pos = end + 1;
+		}
+	}
+
+	/**
+	 * `ini.get_to(val)` for the members and items of a value, that is read already. Only the outermost `get_to()`
+	 * checks for an active `IniMetrics`, nested values call their `from_ini()` directly.
+	 */
+	template<HasFromIni T>
+	void getNested(const Ini& ini, T& val) {
+		from_ini(val, ini);
+	}
+
+	template<typename T>
+	requires (!HasFromIni<T>)
+	void getNested(const Ini& ini, T& val) {
+		ini.get_to(val);
+	}
+
+	template<typename T>
+	void getNested(const Ini& ini, std::optional<T>& val) {
+		ini.get_to(val);
+	}
+
+	/**
+	 * Reads an array (or an object with index keys) into a resizable container.
+	 * The container gets one element per index up to the highest one, missing indices are default constructed.
+	 * Single values are read as a list separated by `,`, if the elements are single values as well.
+	 */
+	template<typename Container>
+	void readArray(Container& obj, const Ini& ini) {
+		if constexpr (isIniValue<std::ranges::range_value_t<Container>>) {
+			if (ini.isValue()) {
+				parseList(ini.get<std::string_view>(), ',', obj);
+				return;
+			}
+		}
+		if (!ini.isArray() && !ini.isObject()) {
+			return;
+		}
+
+		size_t size = ini.isArray() ? ini.size() : 0;
+		if (!ini.isArray()) {
+			ini.for_each_index([&size](size_t index, const Ini&) {
+				size = std::max(size, index + 1);
+			});
+		}
+
+		obj.clear();
+		obj.resize(size);
+		ini.for_each_index([&obj](size_t index, const Ini& element) {
+			if constexpr (std::is_reference_v<std::ranges::range_reference_t<Container>>) {
+				getNested(element, obj[index]);
+			} else {
+				// proxies like the ones of `std::vector<bool>`
+				std::ranges::range_value_t<Container> item{};
+				getNested(element, item);
+				obj[index] = std::move(item);
+			}
+		});
+	}
+
+	// reads into a container with a fixed size, indices outside of it are ignored
+	template<typename Container>
+	void readFixedArray(Container& obj, const Ini& ini) {
+		if constexpr (isIniValue<std::ranges::range_value_t<Container>>) {
+			if (ini.isValue()) {
+				parseList(ini.get<std::string_view>(), ',', obj);
+				return;
+			}
+		}
+		ini.for_each_index([&obj](size_t index, const Ini& element) {
+			if (index < std::size(obj)) {
+				getNested(element, obj[index]);
+			}
+		});
+	}
+
+	template<typename Container>
+	void writeArray(const Container& obj, Ini& ini) {
+		ini.resize(std::size(obj));
+		size_t index = 0;
+		for (const auto& val : obj) {
+			ini[index++] = val;
+		}
+	}
+
+	template<typename Container>
+	void writeArray(const Container& obj, IniWriter& writer) {
+		// values have to be written before all sections
+		for (size_t i = 0; i < std::size(obj); ++i) {
+			writer.write_value(std::to_string(i), obj[i]);
+		}
+		for (size_t i = 0; i < std::size(obj); ++i) {
+			writer.write_section(std::to_string(i), obj[i]);
+		}
+	}
+
+	// converts the key of a map without going through an `Ini`, if possible
+	template<typename Key>
+	void keyFromString(const std::string& str, Key& key) {
+		if constexpr (isIniValue<Key>) {
+			parseValue(str, key);
+		} else {
+			Ini(str).get_to(key);
+		}
+	}
+
+	template<typename Key>
+	std::string keyToString(const Key& key) {
+		if constexpr (std::is_same_v<Key, std::string>) {
+			return key;
+		} else if constexpr (std::is_integral_v<Key> || std::is_floating_point_v<Key>) {
+			return std::format("{}", key);
+		} else if constexpr (HasEnumNames<Key>) {
+			return std::string(ini_enum_name(key));
+		} else {
+			return Ini(key).get<std::string>();
+		}
+	}
+
+	template<typename Map>
+	void writeMap(const Map& obj, Ini& ini) {
+		for (const auto& [key, val] : obj) {
+			ini[keyToString(key)] = val;
+		}
+	}
+
+	template<typename Map>
+	void writeMap(const Map& obj, IniWriter& writer) {
+		// values have to be written before all sections
+		for (const auto& [key, val] : obj) {
+			writer.write_value(keyToString(key), val);
+		}
+		for (const auto& [key, val] : obj) {
+			writer.write_section(keyToString(key), val);
+		}
+	}
+}
+
+export namespace modernIni {
+	template<typename Container>
+	void Ini::get_to(Container& val, char separator) const {
+		if constexpr (detail::isIniValue<std::ranges::range_value_t<Container>>) {
+			if (isValue()) {
+				detail::parseList(value, separator, val);
+				return;
+			}
+		}
+		get_to(val);
+	}
+
+	/**
+	 * Binding for the member `Member` of `T`, called `name` in the ini.
+	 * This is used by the `MODERN_INI_DEFINE_TYPE_*` macros to generate `ini_fields()`.
+	 */
+	template<typename T, auto Member>
+	constexpr FieldBinding makeField(std::string_view name) {
+		using MemberType = std::remove_cvref_t<decltype(std::declval<T&>().*Member)>;
+
+		FieldBinding field{ name };
+		field.bind = [](void* obj, const Ini& ini) {
+			detail::getNested(ini, static_cast<T*>(obj)->*Member);
+		};
+		field.member = [](void* obj) -> void* {
+			return std::addressof(static_cast<T*>(obj)->*Member);
+		};
+		field.store = [](const void* obj, Ini& ini) {
+			ini = static_cast<const T*>(obj)->*Member;
+		};
+		field.write = [](const void* obj, IniWriter& writer, std::string_view name, bool section) {
+			const auto& member = static_cast<const T*>(obj)->*Member;
+			if (section) {
+				writer.write_section(std::string(name), member);
+			} else {
+				writer.write_value(std::string(name), member);
+			}
+		};
+		if constexpr (detail::isIniValue<MemberType>) {
+			field.assign = [](void* member, std::string_view value) {
+				detail::parseValue(value, *static_cast<MemberType*>(member));
+			};
+			field.check = [](std::string_view value) {
+				MemberType val = {};
+				return detail::parseValue(value, val);
+			};
+		}
+		if constexpr (HasIniFields<MemberType>) {
+			field.table = [] {
+				return ini_fields(std::type_identity<MemberType>{});
+			};
+		}
+		return field;
+	}
+
+	/**
+	 * Reads `input` directly into `obj`, without building an `Ini` tree in between.
+	 * The result is the same as reading it with `operator>>` and calling `get_to()`, sections are written into the nested structs.
+	 */
+	template<HasIniFields T>
+	void parse_into(std::istream& input, T& obj) {
+		detail::StructParser parser(std::addressof(obj), ini_fields(std::type_identity<T>{}));
+		detail::tokenize(input, parser);
+		parser.finish();
+	}
+
+	template<HasIniFields T>
+	void parse_into(std::string_view input, T& obj) {
+		detail::StructParser parser(std::addressof(obj), ini_fields(std::type_identity<T>{}));
+		detail::tokenize(input, parser);
+		parser.finish();
+	}
+
+	template<HasIniFields T>
+	T parse_into(std::istream& input) {
+		T obj = {};
+		parse_into(input, obj);
+		return obj;
+	}
+
+	template<HasIniFields T>
+	T parse_into(std::string_view input) {
+		T obj = {};
+		parse_into(input, obj);
+		return obj;
+	}
+
+	// thrown when the input doesn't match a `Schema`
+	class SchemaError : public std::runtime_error {
+	private:
+		size_t errorLine;
+
+	public:
+		SchemaError(const std::string& message, size_t new_line) :
+			std::runtime_error(new_line == 0 ? message : std::format("{} (line {})", message, new_line)), errorLine(new_line) { }
+
+		// line of the error starting at 1, 0 for missing elements, which are only found at the end of the input
+		size_t line() const {
+			return errorLine;
+		}
+	};
+
+	/**
+	 * Describes the sections and keys an ini has to contain. It is built in code or with `from<T>()` from the `MODERN_INI_DEFINE_TYPE_*` macros.
+	 * Sections are given in the category format (e.g. `[cat][subcat]`), the root section is an empty string.
+	 * The rules are kept sorted while they are added, so checking a line while parsing is a binary search.
+	 * Keys and sections without a rule are allowed.
+	 */
+	class Schema {
+		template<typename Handler>
+		friend class detail::SchemaValidator;
+
+	public:
+		enum class ValueType {
+			String,
+			Integer,
+			Float,
+			Bool
+		};
+
+	private:
+		enum class Kind : uint8_t {
+			Value,
+			Section,
+			// e.g. containers, that can be a single value or a section
+			Any
+		};
+
+		struct KeyRule {
+			std::string name;
+			Kind kind = Kind::Any;
+			bool required = false;
+			bool (*check)(std::string_view value) = nullptr;
+			std::optional<double> min;
+			std::optional<double> max;
+			// index of the section, for `Kind::Section`
+			size_t section = 0;
+		};
+
+		struct SectionRule {
+			std::string categories;
+			// sorted by name
+			std::vector<KeyRule> keys;
+		};
+
+		// the root section is the first one
+		std::vector<SectionRule> sections{ SectionRule() };
+
+		static constexpr size_t npos = std::string::npos;
+
+		size_t findKey(size_t section, std::string_view name) const {
+			const std::vector<KeyRule>& keys = sections[section].keys;
+			auto found = std::ranges::lower_bound(keys, name, {}, &KeyRule::name);
+			if (found == keys.end() || found->name != name) {
+				return npos;
+			}
+			return found - keys.begin();
+		}
+
+		KeyRule& addKey(size_t section, std::string_view name) {
+			std::vector<KeyRule>& keys = sections[section].keys;
+			auto found = std::ranges::lower_bound(keys, name, {}, &KeyRule::name);
+			if (found == keys.end() || found->name != name) {
+				found = keys.insert(found, KeyRule{ std::string(name) });
+			}
+			return *found;
+		}
+
+		size_t childSection(size_t parent, std::string_view name, bool required) {
+			KeyRule& rule = addKey(parent, name);
+			rule.required = required;
+			if (rule.kind == Kind::Section) {
+				return rule.section;
+			}
+
+			rule.kind = Kind::Section;
+			rule.section = sections.size();
+			std::string categories = std::format("{}[{}]", sections[parent].categories, name);
+			sections.push_back({ std::move(categories) });
+			return sections.size() - 1;
+		}
+
+		// index of the section, it is created with all its parents if needed (not required, if they don't exist yet)
+		size_t sectionIndex(std::string_view categories) {
+			size_t section = 0;
+			size_t pos = categories.find('[');
+			while (pos != std::string_view::npos) {
+				const size_t end = categories.find(']', pos);
+				if (end == std::string_view::npos) {
+					break;
+				}
+				const std::string_view name = categories.substr(pos + 1, end - pos - 1);
+				const size_t index = findKey(section, name);
+				if (index != npos && sections[section].keys[index].kind == Kind::Section) {
+					section = sections[section].keys[index].section;
+				} else {
+					section = childSection(section, name, false);
+				}
+				pos = categories.find('[', end);
+			}
+			return section;
+		}
+
+		void addFields(size_t section, const FieldTable& table) {
+			for (const FieldBinding& field : table.fields) {
+				if (field.table != nullptr) {
+					addFields(childSection(section, field.name, table.required), field.table());
+					continue;
+				}
+
+				KeyRule& rule = addKey(section, field.name);
+				rule.kind = field.check != nullptr ? Kind::Value : Kind::Any;
+				rule.check = field.check;
+				rule.required = table.required;
+			}
+		}
+
+	public:
+		// a section, that has to exist when its parent section exists
+		Schema& section(std::string_view categories, bool required = true) {
+			const size_t split = categories.rfind('[');
+			if (split == std::string_view::npos || categories.back() != ']') {
+				return *this;
+			}
+			const size_t parent = sectionIndex(categories.substr(0, split));
+			childSection(parent, categories.substr(split + 1, categories.size() - split - 2), required);
+			return *this;
+		}
+
+		// a single value, that has to be convertible into `T`
+		template<typename T>
+		Schema& value(std::string_view categories, std::string_view key, bool required = true) {
+			KeyRule& rule = addKey(sectionIndex(categories), key);
+			rule.kind = Kind::Value;
+			rule.required = required;
+			rule.check = [](std::string_view value) {
+				T val = {};
+				return detail::parseValue(value, val);
+			};
+			return *this;
+		}
+
+		Schema& value(std::string_view categories, std::string_view key, ValueType type, bool required = true) {
+			switch (type)
+			{
+			case ValueType::Integer:
+				return value<int64_t>(categories, key, required);
+			case ValueType::Float:
+				return value<double>(categories, key, required);
+			case ValueType::Bool:
+				return value<bool>(categories, key, required);
+			default:
+				return value<std::string>(categories, key, required);
+			}
+		}
+
+		// numeric values outside of [min, max] are rejected, keys without a rule become optional numbers
+		Schema& range(std::string_view categories, std::string_view key, double min, double max) {
+			KeyRule* rule = &addKey(sectionIndex(categories), key);
+			if (rule->kind != Kind::Value) {
+				value<double>(categories, key, false);
+				rule = &addKey(sectionIndex(categories), key);
+			}
+			rule->min = min;
+			rule->max = max;
+			return *this;
+		}
+
+		// the fields of `T` with their types, they are required if `T` throws on missing values
+		template<HasIniFields T>
+		static Schema from() {
+			Schema schema;
+			schema.addFields(0, ini_fields(std::type_identity<T>{}));
+			return schema;
+		}
+	};
+}
+
+namespace modernIni::detail {
+	/**
+	 * Handler for `tokenize()`, that checks every line against a `Schema` before passing it on to `handler`.
+	 * Invalid values throw right away, missing keys and sections are checked by `finish()`.
+	 */
+	template<typename Handler>
+	class SchemaValidator {
+	private:
+		using Kind = Schema::Kind;
+		static constexpr size_t npos = Schema::npos;
+
+		const Schema& schema;
+		Handler& handler;
+		// keys that were found, by section and key index
+		std::vector<std::vector<bool>> found;
+		// the current section, `npos` for sections without rules
+		size_t current = 0;
+
+		void checkMissing(size_t index) const {
+			const Schema::SectionRule& rules = schema.sections[index];
+			for (size_t i = 0; i < rules.keys.size(); ++i) {
+				const Schema::KeyRule& rule = rules.keys[i];
+				if (!found[index][i]) {
+					if (rule.required) {
+						if (rule.kind == Kind::Section) {
+							throw SchemaError(std::format("Missing section `{}[{}]`", rules.categories, rule.name), 0);
+						}
+						throw SchemaError(std::format("Missing key `{}{}`", rules.categories, rule.name), 0);
+					}
+				} else if (rule.kind == Kind::Section) {
+					checkMissing(rule.section);
+				}
+			}
+		}
+
+	public:
+		SchemaValidator(const Schema& new_schema, Handler& new_handler) :
+			schema(new_schema), handler(new_handler) {
+			found.reserve(schema.sections.size());
+			for (const Schema::SectionRule& rules : schema.sections) {
+				found.emplace_back(rules.keys.size(), false);
+			}
+		}
+
+		void section(const std::vector<std::string_view>& categories, const LineSource& line) {
+			current = 0;
+			for (std::string_view category : categories) {
+				const size_t index = schema.findKey(current, category);
+				if (index == npos) {
+					current = npos;
+					break;
+				}
+
+				const Schema::KeyRule& rule = schema.sections[current].keys[index];
+				if (rule.kind == Kind::Value) {
+					throw SchemaError(std::format("Expected a value for `{}{}`, found a section", schema.sections[current].categories, category), line.number);
+				}
+				found[current][index] = true;
+				if (rule.kind != Kind::Section) {
+					current = npos;
+					break;
+				}
+				current = rule.section;
+			}
+
+			handler.section(categories, line);
+		}
+
+		void value(std::string_view key, std::string_view value, const LineSource& line) {
+			const size_t index = current != npos ? schema.findKey(current, key) : npos;
+			// only the first occurrence of a key is used by `operator>>`
+			if (index != npos && !found[current][index]) {
+				found[current][index] = true;
+
+				const Schema::KeyRule& rule = schema.sections[current].keys[index];
+				const std::string& categories = schema.sections[current].categories;
+				if (rule.kind == Kind::Section) {
+					throw SchemaError(std::format("Expected a section for `{}[{}]`, found a value", categories, key), line.number);
+				}
+				if (rule.check != nullptr && !rule.check(value)) {
+					throw SchemaError(std::format("Invalid value for `{}{}`", categories, key), line.number);
+				}
+				if (rule.min || rule.max) {
+					double number = 0;
+					const char* end = value.data() + value.size();
+					auto [ptr, ec] = std::from_chars(value.data(), end, number);
+					if (ec != std::errc() || ptr != end || (rule.min && number < *rule.min) || (rule.max && number > *rule.max)) {
+						throw SchemaError(std::format("Value of `{}{}` is out of range", categories, key), line.number);
+					}
+				}
+			}
+
+			handler.value(key, value, line);
+		}
+
+		void finish() const {
+			checkMissing(0);
+		}
+	};
+}
+
+export namespace modernIni {
+	/**
+	 * Reads `input` like `operator>>`, but checks every line against `schema` while reading.
+	 * Throws `SchemaError` on the first error, `ini` then contains everything read up to that point.
+	 */
+	void parse(std::istream& input, Ini& ini, const Schema& schema) {
+		Ini::Builder builder(ini);
+		detail::SchemaValidator validator(schema, builder);
+		detail::tokenize(input, validator);
+		validator.finish();
+	}
+
+	// `parse_into()`, that checks the input against `schema` while reading
+	template<HasIniFields T>
+	void parse_into(std::istream& input, T& obj, const Schema& schema) {
+		detail::StructParser parser(std::addressof(obj), ini_fields(std::type_identity<T>{}));
+		detail::SchemaValidator validator(schema, parser);
+		detail::tokenize(input, validator);
+		validator.finish();
+		parser.finish();
+	}
+
+	template<HasIniFields T>
+	void parse_into(std::string_view input, T& obj, const Schema& schema) {
+		detail::StructParser parser(std::addressof(obj), ini_fields(std::type_identity<T>{}));
+		detail::SchemaValidator validator(schema, parser);
+		detail::tokenize(input, validator);
+		validator.finish();
+		parser.finish();
+	}
+
+}
+
+namespace modernIni::detail {
+	// layout of the files written by `Ini::save_binary()`, all values in native byte order
+	struct BinaryHeader {
+		std::array<char, 8> magic;
+		uint32_t version;
+		uint32_t nodeCount;
+		uint64_t stringsOffset;
+		uint64_t stringsSize;
+		// FNV-1a of everything after the header
+		uint64_t checksum;
+	};
+
+	constexpr std::array<char, 8> binaryMagic = { 'M', 'I', 'N', 'I', 'B', 'I', 'N', '\0' };
+	constexpr uint32_t binaryVersion = 1;
+
+	/**
+	 * Nodes are stored breadth first, so the sub elements of a node are next to each other, starting at `firstChild`.
+	 * Objects have their sub elements sorted by key, arrays by index. Strings are offsets into the string pool.
+	 */
+	struct BinaryNode {
+		uint32_t keyOffset;
+		uint32_t keyLength;
+		uint32_t valueOffset;
+		uint32_t valueLength;
+		uint32_t firstChild;
+		uint32_t childCount;
+		Type type;
+	};
+
+	inline uint64_t fnv1a(std::string_view data, uint64_t hash = 0xcbf29ce484222325) {
+		for (char c : data) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 0x100000001b3;
+		}
+		return hash;
+	}
+
+	// temporary file next to `path`, the name is unique between the threads and processes writing `path`
+	std::filesystem::path temporaryPath(const std::filesystem::path& path) {
+		static std::atomic<uint64_t> counter = 0;
+#ifdef _WIN32
+		const auto process = GetCurrentProcessId();
+#else
+		const auto process = getpid();
+#endif
+		std::filesystem::path result = path;
+		result += std::format(".{}.{}.tmp", process, counter.fetch_add(1, std::memory_order_relaxed));
+		return result;
+	}
+
+	// read-only memory mapping of a whole file
+	class MappedFile {
+	private:
+		const char* mappedData = nullptr;
+		size_t mappedSize = 0;
+#ifdef _WIN32
+		HANDLE mapping = nullptr;
+#endif
+
+		void unmap() {
+#ifdef _WIN32
+			if (mappedData != nullptr) {
+				UnmapViewOfFile(mappedData);
+			}
+			if (mapping != nullptr) {
+				CloseHandle(mapping);
+			}
+			mapping = nullptr;
+#else
+			if (mappedData != nullptr) {
+				munmap(const_cast<char*>(mappedData), mappedSize);
+			}
+#endif
+			mappedData = nullptr;
+			mappedSize = 0;
+		}
+
+	public:
+		// throws `std::runtime_error` if the file can't be mapped
+		explicit MappedFile(const std::filesystem::path& path) {
+			std::error_code error;
+			mappedSize = static_cast<size_t>(std::filesystem::file_size(path, error));
+			if (error || mappedSize == 0) {
+				throw std::runtime_error("Unable to map binary file");
+			}
+#ifdef _WIN32
+			HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				throw std::runtime_error("Unable to map binary file");
+			}
+			mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			// the mapping keeps the file open
+			CloseHandle(file);
+			if (mapping != nullptr) {
+				mappedData = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			}
+#else
+			const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (file < 0) {
+				throw std::runtime_error("Unable to map binary file");
+			}
+			void* mapped = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, file, 0);
+			// the mapping keeps the file open
+			close(file);
+			if (mapped != MAP_FAILED) {
+				mappedData = static_cast<const char*>(mapped);
+			}
+#endif
+			if (mappedData == nullptr) {
+				unmap();
+				throw std::runtime_error("Unable to map binary file");
+			}
+		}
+
+		MappedFile(MappedFile&& other) noexcept :
+			mappedData(std::exchange(other.mappedData, nullptr)), mappedSize(std::exchange(other.mappedSize, 0))
+#ifdef _WIN32
+			, mapping(std::exchange(other.mapping, nullptr))
+#endif
+		{ }
 
-			for (const Ini& element : subElements | std::views::values) {
-				if (element.type == Type::Value) {
-					return true;
-				}
-			}
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
 
-			return false;
+		~MappedFile() {
+			unmap();
 		}
 
-		inline bool isObject() const {
-			return type == Type::Object;
+		std::string_view data() const {
+			return { mappedData, mappedSize };
 		}
+	};
+}
 
-		inline bool isValue() const {
-			return type == Type::Value;
-		}
+export namespace modernIni {
+	/**
+	 * Read-only view of a file written by `Ini::save_binary()`, created with `Ini::map_binary()`.
+	 * Lookups are served directly from the mapped pages without parsing, processes mapping the same file share its pages.
+	 * Nodes returned by it are only valid as long as the `BinaryIni` exists.
+	 */
+	class BinaryIni {
+	public:
+		class Node {
+			friend class BinaryIni;
 
-		bool has(const std::string& key) const {
-			if (!isObject()) {
-				return false;
-			}
-			return subElements.contains(key);
-		}
+		private:
+			const BinaryIni* image;
+			const detail::BinaryNode* node;
 
-		/**
-		 * This produces a string in the ini file category format. e.g. `[cat][subcat][subsubcat]`
-		 */
-		std::string getCategories() const {
-			std::stringstream ss;
-			if (parent != nullptr) {
-				ss << parent->getCategories();
+			Node(const BinaryIni* new_image, const detail::BinaryNode* new_node) :
+				image(new_image), node(new_node) { }
+
+			std::span<const detail::BinaryNode> children() const {
+				return { image->nodes + node->firstChild, node->childCount };
 			}
-			if (!key.empty()) {
-				ss << "[" << key << "]";
+
+		public:
+			std::string_view key() const {
+				return image->string(node->keyOffset, node->keyLength);
 			}
 
-			return ss.str();
-		}
+			// empty for objects and arrays
+			std::string_view value() const {
+				return image->string(node->valueOffset, node->valueLength);
+			}
 
-		template<HasFromIni T>
-		void get_to(T& val) const {
-			from_ini(val, *this);
-		}
+			bool isObject() const {
+				return node->type == Type::Object;
+			}
 
-		template<IsFromChars T>
-		void get_to(T& val) const {
-			if (!isValue()) return;
-			std::from_chars(value.data(), value.data() + value.size(), val);
-		}
+			bool isValue() const {
+				return node->type == Type::Value;
+			}
 
-		template<EnumHasNoFromIni T>
-		void get_to(T& val) const {
-			if (!isValue()) return;
-			std::underlying_type_t<T> numVal = 0;
-			get_to(numVal);
-			val = static_cast<T>(numVal);
-		}
+			bool isArray() const {
+				return node->type == Type::Array;
+			}
 
-		template<typename T>
-		void get_to(std::optional<T>& val) const {
-			val = get<T>();
-		}
+			size_t size() const {
+				return node->childCount;
+			}
 
-		void get_to(std::string& val) const {
-			if (!isValue()) return;
-			val = value;
-		}
+			// sub elements of objects are found with a binary search, elements of arrays by their index
+			std::optional<Node> find(std::string_view subKey) const {
+				const std::span<const detail::BinaryNode> nodes = children();
+				if (isArray()) {
+					const auto index = detail::parseIndex(subKey);
+					if (!index || *index >= nodes.size()) {
+						return std::nullopt;
+					}
+					return Node(image, &nodes[*index]);
+				}
+				auto found = std::ranges::lower_bound(nodes, subKey, {}, [this](const detail::BinaryNode& element) {
+					return image->string(element.keyOffset, element.keyLength);
+				});
+				if (found == nodes.end() || image->string(found->keyOffset, found->keyLength) != subKey) {
+					return std::nullopt;
+				}
+				return Node(image, &*found);
+			}
 
-		void get_to(bool& val) const {
-			if (!isValue()) return;
-			std::string lowerVal = value;
-			std::transform(lowerVal.begin(), lowerVal.end(), lowerVal.begin(), [](auto& c) {
-				return std::tolower(c);
-			});
-			if (lowerVal == "true" || lowerVal == "on" || lowerVal == "1") {
-				val = true;
-			} else if (lowerVal == "false" || lowerVal == "off" || lowerVal == "0") {
-				val = false;
+			bool has(std::string_view subKey) const {
+				return find(subKey).has_value();
 			}
-		}
 
-		template<typename T>
-		T get() const {
-			T val = {};
-			get_to(val);
-			return std::move(val);
-		}
+			Node at(std::string_view subKey) const {
+				const std::optional<Node> found = find(subKey);
+				if (!found) {
+					throw std::out_of_range("Called `at()` with missing key");
+				}
+				return *found;
+			}
 
-		void erase(const std::string& key) {
-			if (!isObject()) {
-				throw std::out_of_range("Called `erase()` on non-object");
+			Node at(size_t index) const {
+				if (!isArray() || index >= node->childCount) {
+					throw std::out_of_range("Invalid index in `at()`");
+				}
+				return Node(image, &children()[index]);
 			}
 
-			subElements.erase(key);
-		}
+			Node operator[](std::string_view subKey) const {
+				return at(subKey);
+			}
 
-		Ini& at(const std::string& key) {
-			if (!isObject()) {
-				throw std::out_of_range("Called `at()` on non-object");
+			// calls `fn(key, node)` for all sub elements, sorted by key for objects and by index for arrays
+			template<typename F>
+			void for_each(F&& fn) const {
+				for (const detail::BinaryNode& element : children()) {
+					fn(image->string(element.keyOffset, element.keyLength), Node(image, &element));
+				}
 			}
 
-			return subElements.at(key);
-		}
-		const Ini& at(const std::string& key) const {
-			if (!isObject()) {
-				throw std::out_of_range("Called `at()` on non-object");
+			// single values are converted directly, other types are read from a copy made with `load()`
+			template<typename T>
+			void get_to(T& val) const {
+				if constexpr (std::is_same_v<T, std::string_view>) {
+					if (isValue()) {
+						val = value();
+					}
+				} else if constexpr (requires { detail::parseValue(std::string_view(), val); }) {
+					if (isValue()) {
+						detail::parseValue(value(), val);
+					}
+				} else {
+					load().get_to(val);
+				}
 			}
 
-			return subElements.at(key);
-		}
+			template<typename T>
+			T get() const {
+				T val = {};
+				get_to(val);
+				return val;
+			}
 
-		Ini& operator[](const std::string& key) {
-			type = Type::Object;
-			Ini& element = subElements[key];
-			element.parent = this;
-			element.key = key;
-			return element;
-		}
+			// copies this node with all sub elements into an `Ini`
+			Ini load() const {
+				Ini result;
+				image->loadInto(result, *node);
+				return result;
+			}
+		};
 
-		template<HasToIni T>
-		void operator=(const T& val) {
-			type = Type::Object;
-			to_ini(val, *this);
-		}
+	private:
+		detail::MappedFile file;
+		const detail::BinaryNode* nodes = nullptr;
+		std::string_view strings;
 
-		template<typename T>
-		requires std::is_integral_v<T> || std::is_floating_point_v<T>
-		void operator=(const T& val) {
-			type = Type::Value;
-			value = std::format("{}", val);
+		std::string_view string(uint32_t offset, uint32_t length) const {
+			return strings.substr(offset, length);
 		}
 
-		template<EnumHasNoToIni T>
-		void operator=(const T& val) {
-			auto newVal = static_cast<std::underlying_type_t<T>>(val);
-			this->operator=(newVal);
-		}
+		void loadInto(Ini& target, const detail::BinaryNode& node) const {
+			target.key = string(node.keyOffset, node.keyLength);
+			target.type = node.type;
+			if (node.type == Type::Value) {
+				target.value = string(node.valueOffset, node.valueLength);
+				return;
+			}
 
-		template<typename T>
-		void operator=(const std::optional<T>& val) {
-			if (val) {
-				this->operator=(val.value());
+			const std::span<const detail::BinaryNode> children(nodes + node.firstChild, node.childCount);
+			if (node.type == Type::Array) {
+				target.elements.resize(children.size());
+				for (size_t i = 0; i < children.size(); ++i) {
+					loadInto(target.elements[i], children[i]);
+				}
 			} else {
-				// remove this from parent, if parent exists
-				if (parent) {
-					parent->erase(key);
+				for (const detail::BinaryNode& child : children) {
+					loadInto(target.subElements.emplace_hint(target.subElements.end(), string(child.keyOffset, child.keyLength), Ini())->second, child);
 				}
 			}
+			target.setParent(target.parent);
 		}
 
-		void operator=(const std::string& val) {
-			type = Type::Value;
-			value = val;
+		// the string pool and child ranges of all nodes are inside of the file
+		bool validNodes(uint32_t nodeCount) const {
+			for (uint32_t i = 0; i < nodeCount; ++i) {
+				const detail::BinaryNode& node = nodes[i];
+				if (static_cast<uint64_t>(node.keyOffset) + node.keyLength > strings.size()
+					|| static_cast<uint64_t>(node.valueOffset) + node.valueLength > strings.size()
+					|| (node.childCount > 0 && (node.firstChild <= i || static_cast<uint64_t>(node.firstChild) + node.childCount > nodeCount))
+					|| (node.type != Type::Object && node.type != Type::Value && node.type != Type::Array)) {
+					return false;
+				}
+			}
+			return true;
 		}
 
-		bool operator==(const Ini& other) const {
-			if (type != other.type || key != other.key) {
-				return false;
+	public:
+		/**
+		 * Maps the file at `path`, throws `std::runtime_error` if it isn't a binary ini of this version.
+		 * The string and child ranges of all nodes are always checked against the file, so lookups never read outside of it.
+		 * With `verify` the checksum is checked as well, this reads the whole file once.
+		 */
+		explicit BinaryIni(const std::filesystem::path& path, bool verify = true) :
+			file(path) {
+			const std::string_view data = file.data();
+			detail::BinaryHeader header;
+			if (data.size() < sizeof(header)) {
+				throw std::runtime_error("Invalid binary ini");
+			}
+			std::memcpy(&header, data.data(), sizeof(header));
+			if (header.magic != detail::binaryMagic || header.version != detail::binaryVersion) {
+				throw std::runtime_error("Invalid binary ini or different version");
+			}
+			const uint64_t nodesSize = static_cast<uint64_t>(header.nodeCount) * sizeof(detail::BinaryNode);
+			if (header.nodeCount == 0 || sizeof(header) + nodesSize > header.stringsOffset || header.stringsOffset + header.stringsSize != data.size()) {
+				throw std::runtime_error("Invalid binary ini");
 			}
 
-			switch (type)
-			{
-			case Type::Object:
-				return subElements == other.subElements;
-			case Type::Value:
-				return value == other.value;
-			default:
-				break;
+			nodes = reinterpret_cast<const detail::BinaryNode*>(data.data() + sizeof(header));
+			strings = data.substr(static_cast<size_t>(header.stringsOffset));
+			if (!validNodes(header.nodeCount) || (verify && detail::fnv1a(data.substr(sizeof(header))) != header.checksum)) {
+				throw std::runtime_error("Corrupted binary ini");
 			}
+		}
 
-			return false;
+		Node root() const {
+			return Node(this, nodes);
 		}
-	};
 
-	// deserialize from stream
-	std::istream& operator>>(std::istream& input, Ini& ini) {
-		Ini* lastCategory = &ini;
-		
-		// global element always object
-		ini.type = Type::Object;
+		bool has(std::string_view key) const {
+			return root().has(key);
+		}
 
-		while (!input.eof()) {
-			std::string line;
+		std::optional<Node> find(std::string_view key) const {
+			return root().find(key);
+		}
 
-			if (!std::getline(input, line) || line.empty()) {
-				//continue;
-				continue;
-			}
-			else if (line.find('=') != std::string::npos) {
-				// key=value pair or empty
-				size_t splitPos = line.find('=');
-				std::string key = line.substr(0, splitPos);
-				std::string value = line.substr(splitPos + 1);
-				// strip spaces (leading/trailing)
-				key = std::regex_replace(key, std::regex("^ +| +$|( ) +"), "$1");
-				value = std::regex_replace(value, std::regex("^ +| +$|( ) +"), "$1");
+		Node at(std::string_view key) const {
+			return root().at(key);
+		}
 
-				std::stringstream ss;
-				bool decodeNext = false;
-				for (auto letter : value) {
-					if (decodeNext) {
-						decodeNext = false;
-						if (letter == '\\') {
-							ss << letter;
-						} else if (letter == 'n') {
-							ss << '\n';
-						}
-					} else if (letter == '\\') {
-						decodeNext = true;
-					} else {
-						ss << letter;
-					}
-				}
-				value = ss.str();
+		Node operator[](std::string_view key) const {
+			return at(key);
+		}
+	};
 
-				lastCategory->subElements.try_emplace(key, key, value, lastCategory);
+	void Ini::save_binary(const std::filesystem::path& path) const {
+		std::vector<detail::BinaryNode> nodes;
+		std::string strings;
+		// keys repeat a lot (e.g. the same keys in every section), they are stored once
+		std::unordered_map<std::string_view, uint32_t> stringOffsets;
+		auto addString = [&strings, &stringOffsets](std::string_view text) {
+			auto [found, inserted] = stringOffsets.try_emplace(text, static_cast<uint32_t>(strings.size()));
+			if (inserted) {
+				strings += text;
 			}
-			else if (line.find('[') != std::string::npos) {
-				lastCategory = &ini;
-				// this is a category
-				std::regex reg("\\[([^\\[\\]]+?)\\]");
-				std::sregex_iterator next(line.begin(), line.end(), reg);
-				std::sregex_iterator end;
-				while (next != end) {
-					std::smatch match = *next;
-					lastCategory = &lastCategory->operator[](match[1]);
-					lastCategory->type = Type::Object;
-					next++;
-				}
+			return found->second;
+		};
+		auto addNode = [&nodes, &addString](const Ini& element) {
+			detail::BinaryNode node = {};
+			node.keyOffset = addString(element.key);
+			node.keyLength = static_cast<uint32_t>(element.key.size());
+			if (element.type == Type::Value) {
+				node.valueOffset = addString(element.value);
+				node.valueLength = static_cast<uint32_t>(element.value.size());
 			}
+			node.type = element.type;
+			nodes.push_back(node);
+		};
+
+		// breadth first, so the sub elements of every node are next to each other
+		std::vector<const Ini*> sources = { this };
+		addNode(*this);
+		for (size_t i = 0; i < sources.size(); ++i) {
+			nodes[i].firstChild = static_cast<uint32_t>(nodes.size());
+			nodes[i].childCount = static_cast<uint32_t>(sources[i]->size());
+			forEachElement(*sources[i], [&sources, &addNode](const std::string&, const Ini& element) {
+				sources.push_back(&element);
+				addNode(element);
+			});
+		}
+		if (strings.size() > std::numeric_limits<uint32_t>::max() || nodes.size() > std::numeric_limits<uint32_t>::max()) {
+			throw std::length_error("Ini is too large for `save_binary()`");
 		}
 
-		return input;
-	}
+		const std::string_view nodeBytes(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(detail::BinaryNode));
+		detail::BinaryHeader header = {};
+		header.magic = detail::binaryMagic;
+		header.version = detail::binaryVersion;
+		header.nodeCount = static_cast<uint32_t>(nodes.size());
+		header.stringsOffset = sizeof(header) + nodeBytes.size();
+		header.stringsSize = strings.size();
+		header.checksum = detail::fnv1a(strings, detail::fnv1a(nodeBytes));
 
-	// serialize to stream
-	std::ostream& operator<<(std::ostream& output, const Ini& ini) {
-		switch (ini.type)
+		// replaced by renaming, processes that mapped the old file keep it
+		const std::filesystem::path tempPath = detail::temporaryPath(path);
 		{
-		case Type::Object:
-			// write out this categories key-value pairs
-			for (const auto& element : ini.subElements | std::views::values) {
-				if (element.type == Type::Value) {
-					output << element;
-				}
-			}
-
-			// write out this categories subcategories
-			for (const auto& element : ini.subElements | std::views::values) {
-				// check if object has any Value types elements
-				if (element.type == Type::Object) {
-					if (element.hasValueElements()) {
-						output << std::endl << element.getCategories() << std::endl;
-					}
-					output << element;
-				}
-			}
-			break;
-		case Type::Value: {
-			std::string value = ini.value;
-			std::stringstream ss;
-			for (auto letter : value) {
-				if (letter == '\n') {
-					ss << '\\' << 'n';
-				} else if (letter == '\\') {
-					ss << '\\' << '\\';
-				} else {
-					ss << letter;
-				}
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(nodeBytes.data(), nodeBytes.size());
+			stream.write(strings.data(), strings.size());
+			stream.flush();
+			if (!stream) {
+				stream.close();
+				std::filesystem::remove(tempPath);
+				throw std::runtime_error("Unable to write binary file");
 			}
-			output << ini.key << "=" << ss.str() << std::endl;
-			break;
 		}
-		default:
-			break;
+		std::error_code error;
+		std::filesystem::rename(tempPath, path, error);
+		if (error) {
+			std::filesystem::remove(tempPath, error);
+			throw std::runtime_error("Unable to replace binary file, it may still be mapped");
 		}
-		return output;
+	}
+
+	BinaryIni Ini::map_binary(const std::filesystem::path& path, bool verify) {
+		return BinaryIni(path, verify);
 	}
 
 	// C++ default containers
@@ -379,51 +4653,174 @@ export namespace modernIni {
 	// std::array
 	template<typename T, size_t Size>
 	void from_ini(std::array<T, Size>& obj, const Ini& ini) {
-		if (!ini.isObject()) {
+		detail::readFixedArray(obj, ini);
+	}
+	template<typename T, size_t Size>
+	void to_ini(const std::array<T, Size>& obj, Ini& ini) {
+		detail::writeArray(obj, ini);
+	}
+	template<typename T, size_t Size>
+	void to_ini(const std::array<T, Size>& obj, IniWriter& writer) {
+		detail::writeArray(obj, writer);
+	}
+
+	// std::vector
+	template<typename T, typename Allocator>
+	void from_ini(std::vector<T, Allocator>& obj, const Ini& ini) {
+		detail::readArray(obj, ini);
+	}
+	template<typename T, typename Allocator>
+	void to_ini(const std::vector<T, Allocator>& obj, Ini& ini) {
+		detail::writeArray(obj, ini);
+	}
+	template<typename T, typename Allocator>
+	void to_ini(const std::vector<T, Allocator>& obj, IniWriter& writer) {
+		detail::writeArray(obj, writer);
+	}
+
+	// std::deque
+	template<typename T, typename Allocator>
+	void from_ini(std::deque<T, Allocator>& obj, const Ini& ini) {
+		detail::readArray(obj, ini);
+	}
+	template<typename T, typename Allocator>
+	void to_ini(const std::deque<T, Allocator>& obj, Ini& ini) {
+		detail::writeArray(obj, ini);
+	}
+	template<typename T, typename Allocator>
+	void to_ini(const std::deque<T, Allocator>& obj, IniWriter& writer) {
+		detail::writeArray(obj, writer);
+	}
+
+	// std::span, reading only fills the existing elements
+	template<typename T, size_t Extent>
+	void from_ini(std::span<T, Extent>& obj, const Ini& ini) {
+		detail::readFixedArray(obj, ini);
+	}
+	template<typename T, size_t Extent>
+	void to_ini(const std::span<T, Extent>& obj, Ini& ini) {
+		detail::writeArray(obj, ini);
+	}
+	template<typename T, size_t Extent>
+	void to_ini(const std::span<T, Extent>& obj, IniWriter& writer) {
+		detail::writeArray(obj, writer);
+	}
+
+	// std::map
+	template<typename Key, typename Val, typename Compare, typename Allocator>
+	void from_ini(std::map<Key, Val, Compare, Allocator>& obj, const Ini& ini) {
+		if (!ini.isObject() && !ini.isArray()) {
 			return;
 		}
-		for (size_t i = 0; i < Size; ++i) {
-			std::string key = std::to_string(i);
-			if (!ini.has(key)) {
-				continue;
-			}
 
-			T& val = obj[i];
-			ini.at(key).get_to(val);
+		// the sub elements are sorted, so with string keys every element is inserted behind the last one
+		auto hint = obj.end();
+		ini.for_each([&obj, &hint](const std::string& key, const Ini& subIni) {
+			Key realKey = {};
+			detail::keyFromString(key, realKey);
+			auto inserted = obj.try_emplace(hint, std::move(realKey));
+			detail::getNested(subIni, inserted->second);
+			hint = std::next(inserted);
+		});
+	}
+	template<typename Key, typename Val, typename Compare, typename Allocator>
+	void to_ini(const std::map<Key, Val, Compare, Allocator>& obj, Ini& ini) {
+		detail::writeMap(obj, ini);
+	}
+	template<typename Key, typename Val, typename Compare, typename Allocator>
+	void to_ini(const std::map<Key, Val, Compare, Allocator>& obj, IniWriter& writer) {
+		detail::writeMap(obj, writer);
+	}
+
+	// std::unordered_map
+	template<typename Key, typename Val, typename Hash, typename KeyEqual, typename Allocator>
+	void from_ini(std::unordered_map<Key, Val, Hash, KeyEqual, Allocator>& obj, const Ini& ini) {
+		if (!ini.isObject() && !ini.isArray()) {
+			return;
 		}
+
+		obj.reserve(obj.size() + ini.size());
+		ini.for_each([&obj](const std::string& key, const Ini& subIni) {
+			Key realKey = {};
+			detail::keyFromString(key, realKey);
+			detail::getNested(subIni, obj.try_emplace(std::move(realKey)).first->second);
+		});
 	}
-	template<typename T, size_t Size>
-	void to_ini(const std::array<T, Size>& obj, Ini& ini) {
-		for (size_t i = 0; i < Size; ++i) {
-			std::string key = std::to_string(i);
-			ini[key] = obj[i];
+	template<typename Key, typename Val, typename Hash, typename KeyEqual, typename Allocator>
+	void to_ini(const std::unordered_map<Key, Val, Hash, KeyEqual, Allocator>& obj, Ini& ini) {
+		detail::writeMap(obj, ini);
+	}
+	template<typename Key, typename Val, typename Hash, typename KeyEqual, typename Allocator>
+	void to_ini(const std::unordered_map<Key, Val, Hash, KeyEqual, Allocator>& obj, IniWriter& writer) {
+		// sorted by key, so the output doesn't depend on the hash
+		std::vector<std::pair<std::string, const Val*>> entries;
+		entries.reserve(obj.size());
+		for (const auto& [key, val] : obj) {
+			entries.emplace_back(detail::keyToString(key), &val);
+		}
+		std::ranges::sort(entries, {}, &std::pair<std::string, const Val*>::first);
+
+		for (const auto& [key, val] : entries) {
+			writer.write_value(key, *val);
+		}
+		for (const auto& [key, val] : entries) {
+			writer.write_section(key, *val);
 		}
 	}
 
-	// std::map
-	// This implementation is not good :(
-	template<typename Key, typename Val>
-	void from_ini(std::map<Key, Val>& obj, const Ini& ini) {
-		if (!ini.isObject()) {
+#ifdef __cpp_lib_flat_map
+	// std::flat_map
+	template<typename Key, typename Val, typename Compare, typename KeyContainer, typename MappedContainer>
+	void from_ini(std::flat_map<Key, Val, Compare, KeyContainer, MappedContainer>& obj, const Ini& ini) {
+		if (!ini.isObject() && !ini.isArray()) {
+			return;
+		}
+
+		if (!obj.empty()) {
+			// merge into the existing elements
+			ini.for_each([&obj](const std::string& key, const Ini& subIni) {
+				Key realKey = {};
+				detail::keyFromString(key, realKey);
+				detail::getNested(subIni, obj.try_emplace(std::move(realKey)).first->second);
+			});
 			return;
 		}
 
-		for (auto& subElement : ini.subElements) {
-			const std::string& key = subElement.first;
-			Ini temp(key);
-			Key realKey = temp.get<Key>();
-			Val& val = obj[realKey];
-			const Ini& subIni = subElement.second;
-			subIni.get_to(val);
+		// build both containers at once, instead of inserting into the middle of them
+		KeyContainer keys;
+		MappedContainer values;
+		keys.reserve(ini.size());
+		values.reserve(ini.size());
+		ini.for_each([&keys, &values](const std::string& key, const Ini& subIni) {
+			detail::keyFromString(key, keys.emplace_back());
+			detail::getNested(subIni, values.emplace_back());
+		});
+
+		// string keys are already sorted, converted keys (e.g. numbers) might not be
+		const Compare compare = obj.key_comp();
+		const bool sortedUnique = std::ranges::adjacent_find(keys, [&compare](const Key& lhs, const Key& rhs) {
+			return !compare(lhs, rhs);
+		}) == keys.end();
+		if (sortedUnique) {
+			obj.replace(std::move(keys), std::move(values));
+		} else {
+			obj = std::flat_map<Key, Val, Compare, KeyContainer, MappedContainer>(std::move(keys), std::move(values), compare);
 		}
 	}
-	template<typename Key, typename Val>
-	void to_ini(const std::map<Key, Val>& obj, Ini& ini) {
-		for (const auto& val : obj) {
-			const Key key = val.first;
-			Ini iniTemp(key);
-			std::string iniKey = iniTemp.get<std::string>();
-			ini[iniKey] = val.second;
-		}
+	template<typename Key, typename Val, typename Compare, typename KeyContainer, typename MappedContainer>
+	void to_ini(const std::flat_map<Key, Val, Compare, KeyContainer, MappedContainer>& obj, Ini& ini) {
+		detail::writeMap(obj, ini);
+	}
+	template<typename Key, typename Val, typename Compare, typename KeyContainer, typename MappedContainer>
+	void to_ini(const std::flat_map<Key, Val, Compare, KeyContainer, MappedContainer>& obj, IniWriter& writer) {
+		detail::writeMap(obj, writer);
+	}
+#endif
+};
+
+template<>
+struct std::hash<modernIni::Ini> {
+	size_t operator()(const modernIni::Ini& ini) const {
+		return ini.hash();
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+/*
+ * `MODERN_INI_FOR_EACH(f, data, a, b, c)` expands to `f(a, data) f(b, data) f(c, data)`, for up to 1000 arguments.
+ * Up to 100 arguments are counted and the matching `MODERN_INI_FOR_EACH_<n>` is expanded, so every argument costs a single expansion.
+ * Longer lists are split into chunks of 100, each level checks if the 101st argument exists. Macros stay below 127 parameters,
+ * the limit of MSVC, more than 1000 arguments fail with a static_assert. The arguments have to be identifiers (member or enum value names).
+ * `MODERN_INI_EXPAND` is needed by the traditional MSVC preprocessor, that passes `__VA_ARGS__` on as a single argument.
+ */
+
+#define MODERN_INI_EXPAND(x) x
+#define MODERN_INI_CONCAT(a, b) MODERN_INI_CONCAT_IMPL(a, b)
+#define MODERN_INI_CONCAT_IMPL(a, b) a##b
+
+// 1 if there are more than 100 arguments, `MODERN_INI_NONE` fills up missing arguments and is detected by its probe
+#define MODERN_INI_MORE(...) MODERN_INI_EXPAND(MODERN_INI_IS_MORE(MODERN_INI_EXPAND(MODERN_INI_ARG_101(__VA_ARGS__, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE, MODERN_INI_NONE))))
+#define MODERN_INI_ARG_101(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, x, ...) x
+#define MODERN_INI_IS_MORE(x) MODERN_INI_SECOND(MODERN_INI_PROBE_CONCAT(MODERN_INI_PROBE_, x), 1, ~)
+#define MODERN_INI_PROBE_CONCAT(a, b) a##b
+#define MODERN_INI_PROBE_MODERN_INI_NONE ~, 0
+#define MODERN_INI_SECOND(...) MODERN_INI_EXPAND(MODERN_INI_SECOND_IMPL(__VA_ARGS__))
+#define MODERN_INI_SECOND_IMPL(a, b, ...) b
+
+// counts up to 100 arguments
+#define MODERN_INI_COUNT(...) MODERN_INI_EXPAND(MODERN_INI_COUNT_IMPL(__VA_ARGS__, 100, 99, 98, 97, 96, 95, 94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))
+#define MODERN_INI_COUNT_IMPL(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, N, ...) N
+
+#define MODERN_INI_FOR_EACH(f, data, ...) MODERN_INI_FOR_EACH_LEVEL_1(f, data, __VA_ARGS__)
+
+#define MODERN_INI_FOR_EACH_LEVEL_1(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_1_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_1_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_1_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_2(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_2(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_2_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_2_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_2_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_3(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_3(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_3_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_3_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_3_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_4(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_4(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_4_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_4_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_4_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_5(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_5(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_5_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_5_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_5_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_6(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_6(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_6_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_6_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_6_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_7(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_7(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_7_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_7_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_7_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_8(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_8(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_8_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_8_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_8_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_9(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_9(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_9_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_9_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_9_1(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100, ...) MODERN_INI_FOR_EACH_100(f, data, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, _65, _66, _67, _68, _69, _70, _71, _72, _73, _74, _75, _76, _77, _78, _79, _80, _81, _82, _83, _84, _85, _86, _87, _88, _89, _90, _91, _92, _93, _94, _95, _96, _97, _98, _99, _100) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_LEVEL_10(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_10(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_LEVEL_10_, MODERN_INI_MORE(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_10_0(f, data, ...) MODERN_INI_EXPAND(MODERN_INI_CONCAT(MODERN_INI_FOR_EACH_, MODERN_INI_COUNT(__VA_ARGS__))(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_LEVEL_10_1(f, data, ...) [] { static_assert(false, "MODERN_INI_FOR_EACH supports at most 1000 arguments"); }()
+
+#define MODERN_INI_FOR_EACH_1(f, data, x) f(x, data)
+#define MODERN_INI_FOR_EACH_2(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_1(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_3(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_2(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_4(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_3(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_5(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_4(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_6(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_5(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_7(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_6(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_8(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_7(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_9(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_8(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_10(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_9(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_11(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_10(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_12(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_11(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_13(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_12(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_14(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_13(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_15(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_14(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_16(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_15(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_17(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_16(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_18(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_17(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_19(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_18(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_20(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_19(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_21(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_20(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_22(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_21(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_23(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_22(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_24(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_23(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_25(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_24(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_26(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_25(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_27(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_26(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_28(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_27(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_29(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_28(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_30(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_29(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_31(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_30(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_32(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_31(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_33(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_32(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_34(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_33(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_35(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_34(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_36(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_35(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_37(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_36(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_38(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_37(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_39(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_38(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_40(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_39(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_41(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_40(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_42(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_41(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_43(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_42(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_44(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_43(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_45(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_44(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_46(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_45(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_47(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_46(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_48(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_47(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_49(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_48(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_50(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_49(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_51(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_50(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_52(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_51(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_53(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_52(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_54(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_53(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_55(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_54(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_56(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_55(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_57(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_56(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_58(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_57(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_59(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_58(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_60(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_59(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_61(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_60(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_62(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_61(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_63(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_62(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_64(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_63(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_65(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_64(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_66(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_65(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_67(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_66(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_68(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_67(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_69(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_68(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_70(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_69(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_71(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_70(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_72(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_71(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_73(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_72(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_74(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_73(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_75(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_74(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_76(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_75(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_77(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_76(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_78(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_77(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_79(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_78(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_80(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_79(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_81(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_80(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_82(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_81(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_83(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_82(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_84(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_83(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_85(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_84(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_86(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_85(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_87(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_86(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_88(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_87(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_89(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_88(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_90(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_89(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_91(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_90(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_92(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_91(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_93(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_92(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_94(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_93(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_95(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_94(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_96(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_95(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_97(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_96(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_98(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_97(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_99(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_98(f, data, __VA_ARGS__))
+#define MODERN_INI_FOR_EACH_100(f, data, x, ...) f(x, data) MODERN_INI_EXPAND(MODERN_INI_FOR_EACH_99(f, data, __VA_ARGS__))
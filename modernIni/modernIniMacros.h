@@ -2,66 +2,104 @@
 
 import modernIni;
 
-#include "map.h"
+#include <array>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
-#define MODERN_INI_GET_TO_SINGLE_THROWING(key) ini.at(#key).get_to(obj.key);
-#define MODERN_INI_ASSIGN_SINGLE(key) ini[#key] = obj.key;
+#include "modernIniForEach.h"
+
+// the field list is the only part expanded per member, `from_ini()` and `to_ini()` go through the `FieldTable`
+#define MODERN_INI_FIELD_BINDING(key, Type) modernIni::makeField<Type, &Type::key>(#key),
+#define MODERN_INI_FIELD_TABLE(Required, Type, ...) \
+	static constexpr std::array declared{ MODERN_INI_FOR_EACH(MODERN_INI_FIELD_BINDING, Type, __VA_ARGS__) }; \
+	static constexpr auto fields = modernIni::sortFields(declared); \
+	return modernIni::FieldTable{ fields, declared, Required };
+#define MODERN_INI_FROM_INI_FIELDS(Type) \
+	modernIni::from_ini_fields(std::addressof(obj), ini, ini_fields(std::type_identity<Type>{}));
+#define MODERN_INI_TO_INI_FIELDS(Type, target) \
+	modernIni::to_ini_fields(std::addressof(obj), target, ini_fields(std::type_identity<Type>{}));
 
 #define MODERN_INI_DEFINE_TYPE_INTRUSIVE(Type, ...) \
+	friend modernIni::FieldTable ini_fields(std::type_identity<Type>) { \
+		MODERN_INI_FIELD_TABLE(true, Type, __VA_ARGS__) \
+	} \
 	friend void from_ini(Type& obj, const modernIni::Ini& ini) { \
-		MAP(MODERN_INI_GET_TO_SINGLE_THROWING, __VA_ARGS__) \
+		MODERN_INI_FROM_INI_FIELDS(Type) \
 	} \
 	friend void to_ini(const Type& obj, modernIni::Ini& ini) { \
-		MAP(MODERN_INI_ASSIGN_SINGLE, __VA_ARGS__) \
+		MODERN_INI_TO_INI_FIELDS(Type, ini) \
+	} \
+	friend void to_ini(const Type& obj, modernIni::IniWriter& writer) { \
+		MODERN_INI_TO_INI_FIELDS(Type, writer) \
 	}
 
 #define MODERN_INI_DEFINE_TYPE_NON_INTRUSIVE(Type, ...) \
+	inline modernIni::FieldTable ini_fields(std::type_identity<Type>) { \
+		MODERN_INI_FIELD_TABLE(true, Type, __VA_ARGS__) \
+	} \
 	inline void from_ini(Type& obj, const modernIni::Ini& ini) { \
-		MAP(MODERN_INI_GET_TO_SINGLE_THROWING, __VA_ARGS__) \
+		MODERN_INI_FROM_INI_FIELDS(Type) \
 	} \
 	inline void to_ini(const Type& obj, modernIni::Ini& ini) { \
-		MAP(MODERN_INI_ASSIGN_SINGLE, __VA_ARGS__) \
+		MODERN_INI_TO_INI_FIELDS(Type, ini) \
+	} \
+	inline void to_ini(const Type& obj, modernIni::IniWriter& writer) { \
+		MODERN_INI_TO_INI_FIELDS(Type, writer) \
 	}
 
-#define MODERN_INI_GET_TO_SINGLE_NO_EXCEPT(key) if (ini.has(#key)) ini.at(#key).get_to(obj.key);
-
 #define MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(Type, ...) \
+	friend modernIni::FieldTable ini_fields(std::type_identity<Type>) { \
+		MODERN_INI_FIELD_TABLE(false, Type, __VA_ARGS__) \
+	} \
 	friend void from_ini(Type& obj, const modernIni::Ini& ini) noexcept { \
-		MAP(MODERN_INI_GET_TO_SINGLE_NO_EXCEPT, __VA_ARGS__) \
+		MODERN_INI_FROM_INI_FIELDS(Type) \
 	} \
 	friend void to_ini(const Type& obj, modernIni::Ini& ini) { \
-		MAP(MODERN_INI_ASSIGN_SINGLE, __VA_ARGS__) \
+		MODERN_INI_TO_INI_FIELDS(Type, ini) \
+	} \
+	friend void to_ini(const Type& obj, modernIni::IniWriter& writer) { \
+		MODERN_INI_TO_INI_FIELDS(Type, writer) \
 	}
 
 #define MODERN_INI_DEFINE_TYPE_NON_INTRUSIVE_NO_EXCEPT(Type, ...) \
+	inline modernIni::FieldTable ini_fields(std::type_identity<Type>) { \
+		MODERN_INI_FIELD_TABLE(false, Type, __VA_ARGS__) \
+	} \
 	inline void from_ini(Type& obj, const modernIni::Ini& ini) noexcept { \
-		MAP(MODERN_INI_GET_TO_SINGLE_NO_EXCEPT, __VA_ARGS__) \
+		MODERN_INI_FROM_INI_FIELDS(Type) \
 	} \
 	inline void to_ini(const Type& obj, modernIni::Ini& ini) { \
-		MAP(MODERN_INI_ASSIGN_SINGLE, __VA_ARGS__) \
+		MODERN_INI_TO_INI_FIELDS(Type, ini) \
+	} \
+	inline void to_ini(const Type& obj, modernIni::IniWriter& writer) { \
+		MODERN_INI_TO_INI_FIELDS(Type, writer) \
 	}
 
 
-#define MODERN_INI_SERIALIZE_ENUM_SINGLE_FROM(value, key) {#value, key::value}
-#define MODERN_INI_SERIALIZE_ENUM_SINGLE_TO(value, key) {key::value, #value}
-#define MODERN_INI_SERIALIZE_ENUM_SWITCH(value, key) case key::value: return #value;
+#define MODERN_INI_SERIALIZE_ENUM_SINGLE_NAME(value, key) modernIni::EnumName<key>{#value, key::value},
 #define MODERN_INI_SERIALIZE_ENUM(ENUM_TYPE, ...) \
 	static_assert(std::is_enum_v<ENUM_TYPE>, #ENUM_TYPE " must be an enum!"); \
+	inline const auto& ini_enum_table(std::type_identity<ENUM_TYPE>) { \
+		static constexpr auto table = modernIni::makeEnumNameTable(std::array{ \
+			MODERN_INI_FOR_EACH(MODERN_INI_SERIALIZE_ENUM_SINGLE_NAME, ENUM_TYPE, __VA_ARGS__) \
+		}); \
+		return table; \
+	} \
+	inline std::span<const modernIni::EnumName<ENUM_TYPE>> ini_enum_names(std::type_identity<ENUM_TYPE> type) { \
+		return ini_enum_table(type).byName; \
+	} \
+	inline std::string_view ini_enum_name(ENUM_TYPE e) { \
+		return modernIni::enumToName<ENUM_TYPE>(ini_enum_table(std::type_identity<ENUM_TYPE>{}).byValue, e); \
+	} \
 	inline void from_ini(ENUM_TYPE& e, const modernIni::Ini& ini) { \
-		std::map<std::string, ENUM_TYPE> enumIniLookup{ \
-			MAP_LIST_UD(MODERN_INI_SERIALIZE_ENUM_SINGLE_FROM, ENUM_TYPE, __VA_ARGS__) \
-		}; \
-		auto found = enumIniLookup.find(ini.get<std::string>()); \
-		if (found != enumIniLookup.end()) { \
-			e = found->second; \
-		} \
+		modernIni::enumFromName(ini_enum_names(std::type_identity<ENUM_TYPE>{}), ini.get<std::string_view>(), e); \
 	} \
 	inline void to_ini(const ENUM_TYPE& e, modernIni::Ini& ini) { \
-		std::map<ENUM_TYPE, std::string> enumIniLookup{ \
-			MAP_LIST_UD(MODERN_INI_SERIALIZE_ENUM_SINGLE_TO, ENUM_TYPE, __VA_ARGS__) \
-		}; \
-		auto found = enumIniLookup.find(e); \
-		if (found != enumIniLookup.end()) { \
-			ini = found->second; \
+		const std::string_view name = ini_enum_name(e); \
+		if (!name.empty()) { \
+			ini = std::string(name); \
 		} \
 	}
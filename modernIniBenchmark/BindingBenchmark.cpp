@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	struct Limits {
+		int connections = 0;
+		double timeout = 0.;
+		bool keepAlive = false;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Limits, connections, timeout, keepAlive)
+	};
+
+	struct Server {
+		std::string name;
+		std::string host;
+		int port = 0;
+		int workers = 0;
+		float load = 0.f;
+		bool tls = false;
+		Limits limits;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Server, name, host, port, workers, load, tls, limits)
+	};
+
+	Ini readServer() {
+		Ini ini;
+		std::istringstream stream("name=main\nhost=example.org\nport=8080\nworkers=16\nload=0.75\ntls=true\n\n[limits]\nconnections=512\ntimeout=2.5\nkeepAlive=true\n");
+		stream >> ini;
+		return ini;
+	}
+
+	void FromIni(benchmark::State& state) {
+		const Ini ini = readServer();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(ini.get<Server>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(FromIni);
+
+	void ToIni(benchmark::State& state) {
+		const Server server = readServer().get<Server>();
+		for (auto _ : state) {
+			Ini ini;
+			ini = server;
+			benchmark::DoNotOptimize(ini);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(ToIni);
+
+	// `parse_into()` binds the fields while tokenizing, without building an `Ini`
+	void ParseInto(benchmark::State& state) {
+		const std::string document = "name=main\nhost=example.org\nport=8080\nworkers=16\nload=0.75\ntls=true\n\n[limits]\nconnections=512\ntimeout=2.5\nkeepAlive=true\n";
+		for (auto _ : state) {
+			Server server;
+			modernIni::parse_into(document, server);
+			benchmark::DoNotOptimize(server);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document.size()));
+	}
+	BENCHMARK(ParseInto);
+}
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <shared_mutex>
+#include <sstream>
+#include <string>
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::ConfigHandle ConfigHandle;
+
+namespace {
+	Ini makeConfig() {
+		Ini ini;
+		std::stringstream ss("name=server\nport=8080\n\n[limits]\nconnections=512\ntimeout=2.5\n");
+		ss >> ini;
+		return ini;
+	}
+
+	ConfigHandle handle(makeConfig());
+
+	// baseline: the `Ini` is shared with a reader-writer lock
+	Ini lockedIni = makeConfig();
+	std::shared_mutex lockedMutex;
+
+	void ConfigHandleReader(benchmark::State& state) {
+		ConfigHandle::Reader reader = handle.reader();
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(reader->at("limits").at("connections").get<std::string_view>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(ConfigHandleReader)->ThreadRange(1, 64)->UseRealTime();
+
+	void ConfigHandleAcquire(benchmark::State& state) {
+		for (auto _ : state) {
+			std::shared_ptr<const Ini> ini = handle.acquire();
+			benchmark::DoNotOptimize(ini->at("limits").at("connections").get<std::string_view>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(ConfigHandleAcquire)->ThreadRange(1, 64)->UseRealTime();
+
+	void SharedMutex(benchmark::State& state) {
+		for (auto _ : state) {
+			std::shared_lock lock(lockedMutex);
+			benchmark::DoNotOptimize(lockedIni.at("limits").at("connections").get<std::string_view>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(SharedMutex)->ThreadRange(1, 64)->UseRealTime();
+
+	// readers while the first thread publishes a new snapshot every 1024 iterations
+	void ConfigHandleReaderWithPublish(benchmark::State& state) {
+		ConfigHandle::Reader reader = handle.reader();
+		size_t iteration = 0;
+		for (auto _ : state) {
+			if (state.thread_index() == 0 && ++iteration % 1024 == 0) {
+				handle.publish(makeConfig());
+			}
+			benchmark::DoNotOptimize(reader->at("limits").at("connections").get<std::string_view>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(ConfigHandleReaderWithPublish)->ThreadRange(1, 64)->UseRealTime();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "../modernIniCorpus/modernIniCorpus.h"
+
+namespace benchmarkDocuments {
+	enum class Shape : int64_t {
+		// all keys in the root section
+		Flat,
+		// 8 keys per section
+		Sections,
+		// 8 keys per section, sections nested up to 4 levels deep (`[a][b][c][d]`)
+		Nested,
+	};
+
+	inline const char* shapeName(Shape shape) {
+		switch (shape) {
+			case Shape::Flat:
+				return "flat";
+			case Shape::Sections:
+				return "sections";
+			case Shape::Nested:
+				return "nested";
+		}
+		return "";
+	}
+
+	// deterministic document with about `keys` values of mixed types
+	inline std::string makeDocument(Shape shape, int64_t keys) {
+		modernIniCorpus::CorpusOptions options;
+		options.escapeDensity = 0.01;
+		if (shape == Shape::Flat) {
+			options.rootKeys = static_cast<uint64_t>(keys);
+			options.sections = 0;
+		} else {
+			options.rootKeys = 0;
+			options.sections = static_cast<uint64_t>(keys) / 8;
+			options.keysPerSection = { 8, 8 };
+			options.maxDepth = shape == Shape::Nested ? 4 : 1;
+		}
+		return modernIniCorpus::generate(options);
+	}
+
+	// runs every benchmark for all shapes at 64, 1024 and 16384 keys
+	inline void documentArgs(benchmark::internal::Benchmark* benchmark) {
+		benchmark->ArgNames({ "shape", "keys" });
+		benchmark->ArgsProduct({
+			{ static_cast<int64_t>(Shape::Flat), static_cast<int64_t>(Shape::Sections), static_cast<int64_t>(Shape::Nested) },
+			{ 64, 1024, 16384 },
+		});
+	}
+}
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	// `keys` values, whose type is selected by `key % 4`
+	Ini makeDocument(int64_t keys) {
+		Ini ini;
+		for (int64_t i = 0; i < keys; ++i) {
+			Ini& element = ini["key" + std::to_string(i)];
+			switch (i % 4) {
+				case 0:
+					element = i * 7;
+					break;
+				case 1:
+					element = static_cast<double>(i) + 0.25;
+					break;
+				case 2:
+					element = i % 3 == 0;
+					break;
+				default:
+					element = "some text value " + std::to_string(i);
+					break;
+			}
+		}
+		return ini;
+	}
+
+	// keys of `makeDocument()` with the value type `type`
+	std::vector<std::string> documentKeys(int64_t keys, int64_t type) {
+		std::vector<std::string> result;
+		for (int64_t i = type; i < keys; i += 4) {
+			result.push_back("key" + std::to_string(i));
+		}
+		return result;
+	}
+
+	void At(benchmark::State& state) {
+		const Ini ini = makeDocument(state.range(0));
+		const std::vector<std::string> keys = documentKeys(state.range(0), 0);
+		size_t i = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(&ini.at(keys[i++ % keys.size()]));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(At)->Arg(64)->Arg(1024)->Arg(16384);
+
+	void Has(benchmark::State& state) {
+		const Ini ini = makeDocument(state.range(0));
+		std::vector<std::string> keys = documentKeys(state.range(0), 0);
+		// every second lookup misses
+		for (size_t i = 0; i < keys.size(); i += 2) {
+			keys[i] += "_missing";
+		}
+		size_t i = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(ini.has(keys[i++ % keys.size()]));
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Has)->Arg(64)->Arg(1024)->Arg(16384);
+
+	void Subscript(benchmark::State& state) {
+		Ini ini = makeDocument(state.range(0));
+		const std::vector<std::string> keys = documentKeys(state.range(0), 0);
+		size_t i = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(&ini[keys[i++ % keys.size()]]);
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK(Subscript)->Arg(64)->Arg(1024)->Arg(16384);
+
+	// `get<T>()` of an element found before the loop, so only the conversion is measured
+	template<typename T, int64_t Type>
+	void Get(benchmark::State& state) {
+		const Ini ini = makeDocument(64);
+		const std::vector<std::string> keys = documentKeys(64, Type);
+		std::vector<const Ini*> elements;
+		for (const std::string& key : keys) {
+			elements.push_back(&ini.at(key));
+		}
+
+		size_t i = 0;
+		for (auto _ : state) {
+			benchmark::DoNotOptimize(elements[i++ % elements.size()]->get<T>());
+		}
+		state.SetItemsProcessed(state.iterations());
+	}
+	BENCHMARK_TEMPLATE(Get, int, 0);
+	BENCHMARK_TEMPLATE(Get, long long, 0);
+	BENCHMARK_TEMPLATE(Get, double, 1);
+	BENCHMARK_TEMPLATE(Get, float, 1);
+	BENCHMARK_TEMPLATE(Get, bool, 2);
+	BENCHMARK_TEMPLATE(Get, std::string, 3);
+	BENCHMARK_TEMPLATE(Get, std::string_view, 3);
+}
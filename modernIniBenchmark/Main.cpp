@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Counts all heap allocations, so every benchmark reports `allocs_per_iter` and `total_allocated_bytes`
+ * in its JSON output. Results of two commits can be compared with google benchmark's `tools/compare.py`:
+ *   modernIniBenchmark --benchmark_out=before.json --benchmark_out_format=json
+ *   compare.py benchmarks before.json after.json
+ */
+namespace {
+	std::atomic<int64_t> allocations = 0;
+	std::atomic<int64_t> allocatedBytes = 0;
+
+	class AllocationCounter : public benchmark::MemoryManager {
+	private:
+		int64_t startAllocations = 0;
+		int64_t startBytes = 0;
+
+	public:
+		void Start() override {
+			startAllocations = allocations.load(std::memory_order_relaxed);
+			startBytes = allocatedBytes.load(std::memory_order_relaxed);
+		}
+
+		void Stop(Result& result) override {
+			result.num_allocs = allocations.load(std::memory_order_relaxed) - startAllocations;
+			result.total_allocated_bytes = allocatedBytes.load(std::memory_order_relaxed) - startBytes;
+		}
+
+		void Stop(Result* result) override {
+			Stop(*result);
+		}
+	};
+
+	void* countedAllocate(std::size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		allocatedBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+		if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+			return ptr;
+		}
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(std::size_t size) {
+	return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size) {
+	return countedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+int main(int argc, char** argv) {
+	AllocationCounter counter;
+	benchmark::RegisterMemoryManager(&counter);
+
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+		return 1;
+	}
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+	benchmark::RegisterMemoryManager(nullptr);
+	return 0;
+}
@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+#include "Documents.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+using benchmarkDocuments::Shape;
+
+namespace {
+	void Parse(benchmark::State& state) {
+		const Shape shape = static_cast<Shape>(state.range(0));
+		const std::string document = benchmarkDocuments::makeDocument(shape, state.range(1));
+
+		for (auto _ : state) {
+			std::istringstream stream(document);
+			Ini ini;
+			stream >> ini;
+			benchmark::DoNotOptimize(ini);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * document.size()));
+		state.SetLabel(benchmarkDocuments::shapeName(shape));
+	}
+	BENCHMARK(Parse)->Apply(benchmarkDocuments::documentArgs);
+
+	void Serialize(benchmark::State& state) {
+		const Shape shape = static_cast<Shape>(state.range(0));
+		Ini ini;
+		std::istringstream input(benchmarkDocuments::makeDocument(shape, state.range(1)));
+		input >> ini;
+
+		size_t bytes = 0;
+		for (auto _ : state) {
+			std::ostringstream stream;
+			stream << ini;
+			bytes += stream.view().size();
+			benchmark::DoNotOptimize(stream);
+		}
+		state.SetBytesProcessed(static_cast<int64_t>(bytes));
+		state.SetLabel(benchmarkDocuments::shapeName(shape));
+	}
+	BENCHMARK(Serialize)->Apply(benchmarkDocuments::documentArgs);
+}
@@ -0,0 +1,113 @@
+"""
+Measures how long translation units with many `MODERN_INI_DEFINE_TYPE_*` structs take to compile.
+
+Generates `structs_<n>.cpp` for every count and runs the compiler command on it `--runs` times, the fastest run is reported.
+`{source}` in the commands is replaced by the generated file.
+
+`--mode preprocess` only runs the preprocessor, which is the part the macros expand. `--mode compile` (default) compiles
+the translation unit against the `modernIni` module, which includes instantiating the generated field tables and
+enum name tables. The module is built once with `--module-command` before the measured runs:
+
+    python compile_benchmark.py
+    python compile_benchmark.py --mode preprocess
+    python compile_benchmark.py --mode preprocess --command "g++ -std=c++23 -E -I../../modernIni {source} -o /dev/null"
+    python compile_benchmark.py --module-command "" --command "cl /nologo /std:c++latest /EHsc /c /reference modernIni=path/to/modernIni.ifc {source}"
+"""
+
+import argparse
+import os
+import shlex
+import subprocess
+import sys
+import time
+
+FIELD_TYPES = ["int", "float", "double", "bool", "std::string", "long long", "unsigned", "std::optional<int>"]
+
+
+DEFAULT_COMMANDS = {
+    "preprocess": "cl /nologo /std:c++latest /EP /I../../modernIni {source}",
+    "compile": "cl /nologo /std:c++latest /EHsc /c /I../../modernIni /reference modernIni=modernIni.ifc {source}",
+}
+DEFAULT_MODULE_COMMAND = (
+    "cl /nologo /std:c++latest /EHsc /c /TP /interface ../../modernIni/modernIni.ixx /ifcOutput modernIni.ifc /Fo:modernIni.obj"
+)
+
+
+def generate(count, fields, import_module):
+    lines = [
+        "#include <optional>",
+        "#include <string>",
+        "",
+        '#include "modernIniMacros.h"',
+        "",
+    ]
+    if import_module:
+        lines.append("import modernIni;")
+        lines.append("")
+    lines.append("namespace generated {")
+    for i in range(count):
+        lines.append(f"\tenum class Mode{i} {{ First, Second, Third }};")
+        lines.append(f"\tMODERN_INI_SERIALIZE_ENUM(Mode{i}, First, Second, Third)")
+        lines.append("")
+        lines.append(f"\tstruct Config{i} {{")
+        names = []
+        for field in range(fields):
+            names.append(f"field{field}")
+            lines.append(f"\t\t{FIELD_TYPES[(i + field) % len(FIELD_TYPES)]} field{field} = {{}};")
+        names.append("mode")
+        lines.append(f"\t\tMode{i} mode = Mode{i}::First;")
+        lines.append("")
+        lines.append(f"\t\tMODERN_INI_DEFINE_TYPE_INTRUSIVE(Config{i}, {', '.join(names)})")
+        lines.append("\t};")
+        lines.append("")
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+
+def split(command):
+    return shlex.split(command, posix=os.name != "nt")
+
+
+def run(command):
+    return subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--counts", type=int, nargs="+", default=[100, 500], help="structs per translation unit")
+    parser.add_argument("--fields", type=int, default=8, help="fields per struct")
+    parser.add_argument("--runs", type=int, default=3)
+    parser.add_argument("--mode", choices=DEFAULT_COMMANDS.keys(), default="compile")
+    parser.add_argument("--command", help="defaults to MSVC for the selected mode")
+    parser.add_argument("--module-command", default=DEFAULT_MODULE_COMMAND,
+                        help="builds the module before compiling, only used by --mode compile, empty to skip")
+    args = parser.parse_args()
+
+    command_line = args.command if args.command is not None else DEFAULT_COMMANDS[args.mode]
+    if args.mode == "compile" and args.module_command:
+        result = run(split(args.module_command))
+        if result.returncode != 0:
+            print(result.stderr, file=sys.stderr)
+            return 1
+
+    for count in args.counts:
+        source = f"structs_{count}.cpp"
+        with open(source, "w", newline="\n") as file:
+            file.write(generate(count, args.fields, args.mode == "compile"))
+
+        command = split(command_line.replace("{source}", source))
+        best = None
+        for _ in range(args.runs):
+            start = time.perf_counter()
+            result = run(command)
+            elapsed = time.perf_counter() - start
+            if result.returncode != 0:
+                print(result.stderr, file=sys.stderr)
+                return 1
+            best = elapsed if best is None else min(best, elapsed)
+        print(f"{count} structs ({args.mode}): {best:.3f}s")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
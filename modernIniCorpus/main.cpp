@@ -0,0 +1,160 @@
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string_view>
+
+#include "modernIniCorpus.h"
+
+namespace {
+	void printUsage() {
+		std::cerr << "usage: modernIniCorpus [options]\n"
+			"  --output <file>          write to <file> instead of stdout\n"
+			"  --seed <n>               seed of the generator (1)\n"
+			"  --size <n>[K|M|G]        generate sections until at least this many bytes are written\n"
+			"  --sections <n>           number of sections, if no size is given (100)\n"
+			"  --root-keys <n>          keys before the first section (8)\n"
+			"  --depth <n>              maximum nesting depth of sections (1)\n"
+			"  --keys <min>-<max>       keys per section (4-16)\n"
+			"  --key-length <min>-<max> length of keys (3-12)\n"
+			"  --value-length <min>-<max> length of string values (1-32)\n"
+			"  --escapes <p>            chance of a value character to be escaped (0)\n"
+			"  --duplicates <p>         chance of a key to repeat within its section (0)\n";
+	}
+
+	std::optional<uint64_t> parseNumber(std::string_view text) {
+		uint64_t value = 0;
+		auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (ec != std::errc() || end != text.data() + text.size()) {
+			return std::nullopt;
+		}
+		return value;
+	}
+
+	std::optional<uint64_t> parseSize(std::string_view text) {
+		uint64_t factor = 1;
+		if (!text.empty()) {
+			switch (text.back()) {
+				case 'K':
+				case 'k':
+					factor = 1ull << 10;
+					break;
+				case 'M':
+				case 'm':
+					factor = 1ull << 20;
+					break;
+				case 'G':
+				case 'g':
+					factor = 1ull << 30;
+					break;
+			}
+			if (factor != 1) {
+				text.remove_suffix(1);
+			}
+		}
+		const auto value = parseNumber(text);
+		if (!value) {
+			return std::nullopt;
+		}
+		return *value * factor;
+	}
+
+	std::optional<modernIniCorpus::Range> parseRange(std::string_view text) {
+		const size_t split = text.find('-');
+		if (split == std::string_view::npos) {
+			const auto value = parseNumber(text);
+			if (!value) {
+				return std::nullopt;
+			}
+			return modernIniCorpus::Range{ *value, *value };
+		}
+		const auto min = parseNumber(text.substr(0, split));
+		const auto max = parseNumber(text.substr(split + 1));
+		if (!min || !max || *min > *max) {
+			return std::nullopt;
+		}
+		return modernIniCorpus::Range{ *min, *max };
+	}
+
+	std::optional<double> parseChance(std::string_view text) {
+		double value = 0.;
+		auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+		if (ec != std::errc() || end != text.data() + text.size() || value < 0. || value > 1.) {
+			return std::nullopt;
+		}
+		return value;
+	}
+}
+
+int main(int argc, char** argv) {
+	modernIniCorpus::CorpusOptions options;
+	const char* output = nullptr;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view name = argv[i];
+		if (name == "--help" || name == "-h") {
+			printUsage();
+			return 0;
+		}
+		if (i + 1 >= argc) {
+			printUsage();
+			return 1;
+		}
+		const std::string_view arg = argv[++i];
+
+		bool valid = true;
+		auto set = [&valid](auto& target, const auto& value) {
+			if (value) {
+				target = *value;
+			} else {
+				valid = false;
+			}
+		};
+		if (name == "--output") {
+			output = argv[i];
+		} else if (name == "--seed") {
+			set(options.seed, parseNumber(arg));
+		} else if (name == "--size") {
+			set(options.totalBytes, parseSize(arg));
+		} else if (name == "--sections") {
+			set(options.sections, parseNumber(arg));
+		} else if (name == "--root-keys") {
+			set(options.rootKeys, parseNumber(arg));
+		} else if (name == "--depth") {
+			set(options.maxDepth, parseNumber(arg));
+		} else if (name == "--keys") {
+			set(options.keysPerSection, parseRange(arg));
+		} else if (name == "--key-length") {
+			set(options.keyLength, parseRange(arg));
+		} else if (name == "--value-length") {
+			set(options.valueLength, parseRange(arg));
+		} else if (name == "--escapes") {
+			set(options.escapeDensity, parseChance(arg));
+		} else if (name == "--duplicates") {
+			set(options.duplicateKeys, parseChance(arg));
+		} else {
+			valid = false;
+		}
+
+		if (!valid) {
+			std::cerr << "invalid argument: " << name << ' ' << arg << '\n';
+			printUsage();
+			return 1;
+		}
+	}
+
+	if (output != nullptr) {
+		std::ofstream file(output, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			std::cerr << "unable to open " << output << '\n';
+			return 1;
+		}
+		modernIniCorpus::generate(file, options);
+		return file ? 0 : 1;
+	}
+
+	std::ios::sync_with_stdio(false);
+	modernIniCorpus::generate(std::cout, options);
+	return std::cout ? 0 : 1;
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Generator for synthetic ini documents, used by the benchmarks and the stress tests.
+ * The output only depends on the options (including the seed), not on the platform or standard library.
+ */
+namespace modernIniCorpus {
+	// splitmix64, `std::*_distribution` results differ between standard libraries
+	class Random {
+	private:
+		uint64_t state;
+
+	public:
+		explicit Random(uint64_t seed) :
+			state(seed) { }
+
+		uint64_t next() {
+			uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+
+		// uniform in [min, max]
+		uint64_t between(uint64_t min, uint64_t max) {
+			if (max <= min) {
+				return min;
+			}
+			return min + next() % (max - min + 1);
+		}
+
+		// true with the probability `chance`
+		bool chance(double chance) {
+			return static_cast<double>(next() >> 11) * 0x1.0p-53 < chance;
+		}
+	};
+
+	struct Range {
+		uint64_t min;
+		uint64_t max;
+	};
+
+	struct CorpusOptions {
+		uint64_t seed = 1;
+		// sections are generated until at least this many bytes are written, 0 writes exactly `sections` sections
+		uint64_t totalBytes = 0;
+		uint64_t sections = 100;
+		// keys before the first section
+		uint64_t rootKeys = 8;
+		// 1 only generates `[section]`, 3 up to `[a][b][c]`
+		uint64_t maxDepth = 1;
+		Range keysPerSection{ 4, 16 };
+		// without the index suffix, that keeps keys unique within a section
+		Range keyLength{ 3, 12 };
+		// length of string values, numbers and bools are mixed in with their natural length
+		Range valueLength{ 1, 32 };
+		// chance of every string value character to be written as an escape sequence (`\n` or `\\`)
+		double escapeDensity = 0.;
+		// chance of a key to repeat an earlier key of its section
+		double duplicateKeys = 0.;
+	};
+
+	class Generator {
+	private:
+		// remembered sections per depth, new nested sections are added below one of them
+		static constexpr size_t maxParents = 64;
+		static constexpr std::string_view letters = "abcdefghijklmnopqrstuvwxyz";
+		static constexpr std::string_view valueLetters = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789_.-/:";
+
+		const CorpusOptions& options;
+		Random random;
+		std::vector<std::vector<std::string>> parents;
+		std::vector<std::string> keys;
+		uint64_t sectionCount = 0;
+
+		void appendKey(std::string& out, uint64_t index) {
+			if (!keys.empty() && random.chance(options.duplicateKeys)) {
+				out += keys[random.between(0, keys.size() - 1)];
+				return;
+			}
+
+			std::string key;
+			const uint64_t length = std::max<uint64_t>(random.between(options.keyLength.min, options.keyLength.max), 1);
+			for (uint64_t i = 0; i < length; ++i) {
+				key += letters[random.between(0, letters.size() - 1)];
+			}
+			key += std::to_string(index);
+			out += key;
+			keys.push_back(std::move(key));
+		}
+
+		void appendValue(std::string& out) {
+			const uint64_t kind = random.between(0, 7);
+			if (kind < 2) {
+				out += std::to_string(static_cast<int64_t>(random.next() % 2000001) - 1000000);
+			} else if (kind < 4) {
+				out += std::to_string(random.between(0, 99999));
+				out += '.';
+				out += std::to_string(random.between(0, 999));
+			} else if (kind == 4) {
+				out += random.chance(0.5) ? "true" : "false";
+			} else {
+				const uint64_t length = random.between(options.valueLength.min, options.valueLength.max);
+				for (uint64_t i = 0; i < length; ++i) {
+					if (options.escapeDensity > 0. && random.chance(options.escapeDensity)) {
+						out += random.chance(0.5) ? "\\n" : "\\\\";
+					} else if (i > 0 && i + 1 < length && out.back() != ' ' && random.chance(0.1)) {
+						// single spaces inside the value, the parser collapses runs of spaces
+						out += ' ';
+					} else {
+						out += valueLetters[random.between(0, valueLetters.size() - 1)];
+					}
+				}
+			}
+		}
+
+		void appendValues(std::string& out, uint64_t count) {
+			keys.clear();
+			for (uint64_t i = 0; i < count; ++i) {
+				appendKey(out, i);
+				out += '=';
+				appendValue(out);
+				out += '\n';
+			}
+		}
+
+		void appendSection(std::string& out) {
+			const uint64_t depth = random.between(1, std::max<uint64_t>(options.maxDepth, 1));
+
+			// nested below an existing section of the level above
+			std::string path;
+			uint64_t level = depth;
+			while (level > 1 && parents[level - 2].empty()) {
+				--level;
+			}
+			if (level > 1) {
+				const auto& candidates = parents[level - 2];
+				path = candidates[random.between(0, candidates.size() - 1)];
+			}
+			path += "[section" + std::to_string(sectionCount++) + "]";
+
+			auto& siblings = parents[level - 1];
+			if (siblings.size() < maxParents) {
+				siblings.push_back(path);
+			} else {
+				siblings[random.between(0, maxParents - 1)] = path;
+			}
+
+			out += '\n';
+			out += path;
+			out += '\n';
+			appendValues(out, random.between(options.keysPerSection.min, options.keysPerSection.max));
+		}
+
+	public:
+		explicit Generator(const CorpusOptions& new_options) :
+			options(new_options), random(new_options.seed), parents(std::max<uint64_t>(new_options.maxDepth, 1)) { }
+
+		// writes the document in chunks, so multi-GB documents are never held in memory, returns the written bytes
+		uint64_t write(std::ostream& out) {
+			std::string chunk;
+			uint64_t written = 0;
+			auto flush = [&out, &chunk, &written] {
+				out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+				written += chunk.size();
+				chunk.clear();
+			};
+
+			appendValues(chunk, options.rootKeys);
+			for (uint64_t i = 0; options.totalBytes > 0 ? written + chunk.size() < options.totalBytes : i < options.sections; ++i) {
+				appendSection(chunk);
+				if (chunk.size() >= 64 * 1024) {
+					flush();
+				}
+			}
+			flush();
+			return written;
+		}
+	};
+
+	inline uint64_t generate(std::ostream& out, const CorpusOptions& options) {
+		return Generator(options).write(out);
+	}
+
+	inline std::string generate(const CorpusOptions& options) {
+		std::ostringstream stream;
+		generate(stream, options);
+		return std::move(stream).str();
+	}
+}
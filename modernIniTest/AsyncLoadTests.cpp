@@ -0,0 +1,207 @@
+#include "pch.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	std::filesystem::path writeFile(const std::string& name, const std::string& content) {
+		auto path = std::filesystem::current_path();
+		path.append(name);
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << content;
+		return path;
+	}
+
+	std::string largeContent() {
+		std::string content;
+		for (int i = 0; i < 2000; ++i) {
+			content += "[section" + std::to_string(i) + "]\n";
+			content += "value=" + std::to_string(i) + "\n";
+			content += "text=some longer text of section " + std::to_string(i) + "\n\n";
+		}
+		return content;
+	}
+
+	// minimal coroutine type, that reports its result through a `std::promise`
+	struct Task {
+		struct promise_type {
+			std::promise<Ini> result;
+
+			Task get_return_object() {
+				return Task{ result.get_future() };
+			}
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_value(Ini ini) {
+				result.set_value(std::move(ini));
+			}
+			void unhandled_exception() {
+				result.set_exception(std::current_exception());
+			}
+		};
+
+		std::future<Ini> future;
+	};
+
+	Task loadTask(std::filesystem::path path, modernIni::AsyncLoadOptions options) {
+		co_return co_await modernIni::async_load(path, options);
+	}
+
+	// waits until `count` coroutines arrived, false after a timeout
+	struct Barrier {
+		std::mutex mutex;
+		std::condition_variable condition;
+		int arrived = 0;
+
+		bool arriveAndWait(int count) {
+			std::unique_lock lock(mutex);
+			++arrived;
+			condition.notify_all();
+			return condition.wait_for(lock, std::chrono::seconds(10), [this, count] {
+				return arrived >= count;
+			});
+		}
+	};
+
+	Task blockingTask(std::filesystem::path path, Barrier& barrier, int count) {
+		Ini ini = co_await modernIni::async_load(path);
+		if (!barrier.arriveAndWait(count)) {
+			throw std::runtime_error("coroutines were not resumed");
+		}
+		co_return ini;
+	}
+
+	Task threadTask(std::filesystem::path path, modernIni::AsyncLoadOptions options, std::thread::id& resumedOn) {
+		Ini ini = co_await modernIni::async_load(path, options);
+		resumedOn = std::this_thread::get_id();
+		co_return ini;
+	}
+
+	TEST(AsyncLoadTests, Future) {
+		const std::string content = largeContent();
+		const auto path = writeFile("testAsyncLoad.ini", content);
+
+		Ini expected;
+		std::stringstream ss(content);
+		ss >> expected;
+
+		// small blocks, so that lines are split between blocks
+		Ini ini = modernIni::async_load_future(path, { .blockSize = 97, .maxBlocks = 2 }).get();
+		ASSERT_EQ(ini, expected);
+		ASSERT_EQ(ini.at("section1999").at("text").get<std::string>(), "some longer text of section 1999");
+
+		// fits into a single block
+		ASSERT_EQ(modernIni::async_load_future(path).get(), expected);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(AsyncLoadTests, Coroutine) {
+		const std::string content = largeContent();
+		const auto path = writeFile("testAsyncLoadCoroutine.ini", content);
+
+		Ini expected;
+		std::stringstream ss(content);
+		ss >> expected;
+
+		Task task = loadTask(path, { .blockSize = 4096 });
+		ASSERT_EQ(task.future.get(), expected);
+
+		std::filesystem::remove(path);
+	}
+
+	// more loads than threads of the shared executor, the remaining ones are queued
+	TEST(AsyncLoadTests, ManyLoads) {
+		const std::string content = largeContent();
+		const auto path = writeFile("testAsyncLoadMany.ini", content);
+
+		Ini expected;
+		std::stringstream ss(content);
+		ss >> expected;
+
+		std::vector<std::future<Ini>> futures;
+		std::vector<Task> tasks;
+		for (int i = 0; i < 16; ++i) {
+			futures.push_back(modernIni::async_load_future(path, { .blockSize = 4096, .maxBlocks = 2 }));
+			tasks.push_back(loadTask(path, { .blockSize = 4096, .maxBlocks = 2 }));
+		}
+		for (auto& future : futures) {
+			ASSERT_EQ(future.get(), expected);
+		}
+		for (auto& task : tasks) {
+			ASSERT_EQ(task.future.get(), expected);
+		}
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(AsyncLoadTests, Errors) {
+		auto missing = std::filesystem::current_path();
+		missing.append("testAsyncLoadMissing.ini");
+
+		ASSERT_THROW(modernIni::async_load_future(missing).get(), std::runtime_error);
+		ASSERT_THROW(loadTask(missing, {}).future.get(), std::runtime_error);
+	}
+
+	// more blocking coroutines than threads of the shared executor, all of them are resumed
+	TEST(AsyncLoadTests, BlockingCoroutines) {
+		const auto path = writeFile("testAsyncLoadBlocking.ini", "a=1\n");
+
+		constexpr int count = 8;
+		Barrier barrier;
+		std::vector<Task> tasks;
+		for (int i = 0; i < count; ++i) {
+			tasks.push_back(blockingTask(path, barrier, count));
+		}
+		for (auto& task : tasks) {
+			ASSERT_EQ(task.future.get().at("a").get<int>(), 1);
+		}
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(AsyncLoadTests, Resume) {
+		const auto path = writeFile("testAsyncLoadResume.ini", "a=1\n");
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<std::coroutine_handle<>> queue;
+		modernIni::AsyncLoadOptions options;
+		options.resume = [&](std::coroutine_handle<> handle) {
+			std::lock_guard lock(mutex);
+			queue.push_back(handle);
+			condition.notify_one();
+		};
+
+		// resumed by this thread, like by an event loop
+		std::thread::id resumedOn;
+		Task task = threadTask(path, options, resumedOn);
+		{
+			std::unique_lock lock(mutex);
+			ASSERT_TRUE(condition.wait_for(lock, std::chrono::seconds(10), [&queue] {
+				return !queue.empty();
+			}));
+		}
+		queue.front().resume();
+		ASSERT_EQ(resumedOn, std::this_thread::get_id());
+		ASSERT_EQ(task.future.get().at("a").get<int>(), 1);
+
+		std::filesystem::remove(path);
+	}
+}
@@ -0,0 +1,143 @@
+#include "pch.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::BinaryIni BinaryIni;
+
+namespace {
+	struct Limits {
+		int connections = 0;
+		float timeout = 0.f;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Limits, connections, timeout)
+	};
+
+	std::filesystem::path binaryPath() {
+		auto path = std::filesystem::current_path();
+		path.append("testBinary.ini.bin");
+		return path;
+	}
+
+	const std::string iniString = "name=server\nport=8080\nflag=on\n\n[limits]\nconnections=512\ntimeout=2.5\n\n[limits][sub]\nname=server\n";
+
+	TEST(BinaryTests, Lookup) {
+		const Ini ini = readIni(iniString);
+		const auto path = binaryPath();
+		ini.save_binary(path);
+
+		const BinaryIni binary = Ini::map_binary(path);
+		ASSERT_EQ(binary.at("name").get<std::string>(), "server");
+		ASSERT_EQ(binary.at("name").get<std::string_view>(), "server");
+		ASSERT_EQ(binary["port"].get<int>(), 8080);
+		ASSERT_TRUE(binary.at("flag").get<bool>());
+		ASSERT_EQ(binary.at("limits").at("sub").at("name").value(), "server");
+		ASSERT_TRUE(binary.has("limits"));
+		ASSERT_FALSE(binary.has("missing"));
+		ASSERT_FALSE(binary.at("limits").find("missing").has_value());
+		ASSERT_THROW(binary.at("missing"), std::out_of_range);
+
+		const Limits limits = binary.at("limits").get<Limits>();
+		ASSERT_EQ(limits.connections, 512);
+		ASSERT_EQ(limits.timeout, 2.5f);
+
+		// copies back into the same tree
+		ASSERT_EQ(binary.root().load(), ini);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(BinaryTests, Arrays) {
+		Ini ini;
+		ini["list"].resize(12);
+		for (size_t i = 0; i < 12; ++i) {
+			ini["list"][i] = i * 2;
+		}
+		const auto path = binaryPath();
+		ini.save_binary(path);
+
+		const BinaryIni binary = Ini::map_binary(path);
+		const BinaryIni::Node list = binary.at("list");
+		ASSERT_TRUE(list.isArray());
+		ASSERT_EQ(list.size(), 12u);
+		ASSERT_EQ(list.at(size_t(10)).get<int>(), 20);
+		ASSERT_EQ(list.at("11").get<int>(), 22);
+		ASSERT_EQ(binary.root().load(), ini);
+
+		std::filesystem::remove(path);
+	}
+
+	// the old mapping stays valid while the file is replaced
+	TEST(BinaryTests, SaveWhileMapped) {
+		const auto path = binaryPath();
+		readIni(iniString).save_binary(path);
+
+		const BinaryIni binary = Ini::map_binary(path);
+		const Ini changed = readIni("name=client\n");
+#ifdef _WIN32
+		// Windows can't replace a mapped file
+		ASSERT_THROW(changed.save_binary(path), std::runtime_error);
+		ASSERT_EQ(Ini::map_binary(path).at("name").get<std::string>(), "server");
+#else
+		changed.save_binary(path);
+		ASSERT_EQ(binary.at("name").get<std::string>(), "server");
+		ASSERT_EQ(binary.at("limits").at("connections").get<int>(), 512);
+		ASSERT_EQ(Ini::map_binary(path).at("name").get<std::string>(), "client");
+#endif
+
+		// no temporary files are left behind
+		for (const auto& entry : std::filesystem::directory_iterator(path.parent_path())) {
+			ASSERT_FALSE(entry.path().string().ends_with(".tmp"));
+		}
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(BinaryTests, Corrupted) {
+		const auto path = binaryPath();
+		readIni(iniString).save_binary(path);
+
+		std::string content;
+		{
+			std::ifstream stream(path, std::ios::binary);
+			content.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		}
+		content[content.size() - 2] ^= 1;
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << content;
+		}
+		ASSERT_THROW(Ini::map_binary(path), std::runtime_error);
+		ASSERT_NO_THROW(Ini::map_binary(path, false));
+
+		// offsets are checked without `verify` as well, the children of the root would be outside of the file
+		std::string invalidOffsets = content;
+		const uint32_t firstChild = 0xffffffff;
+		// header of 40 bytes, `firstChild` is the fifth field of the root node
+		std::memcpy(invalidOffsets.data() + 40 + 4 * sizeof(uint32_t), &firstChild, sizeof(firstChild));
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << invalidOffsets;
+		}
+		ASSERT_THROW(Ini::map_binary(path, false), std::runtime_error);
+
+		content[0] = 'X';
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << content;
+		}
+		ASSERT_THROW(Ini::map_binary(path, false), std::runtime_error);
+
+		std::filesystem::remove(path);
+		ASSERT_THROW(Ini::map_binary(path), std::runtime_error);
+	}
+}
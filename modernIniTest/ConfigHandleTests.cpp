@@ -0,0 +1,91 @@
+#include "pch.h"
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::ConfigHandle ConfigHandle;
+
+namespace {
+	TEST(ConfigHandleTests, Publish) {
+		ConfigHandle handle(readIni("a=1\n[cat]\nb=2\n"));
+		ASSERT_EQ(handle.version(), 0u);
+
+		std::shared_ptr<const Ini> first = handle.acquire();
+		ConfigHandle::Reader reader = handle.reader();
+		ASSERT_EQ(reader->at("a").get<int>(), 1);
+		// parents are fixed after moving the element into the snapshot
+		ASSERT_EQ(first->at("cat").at("b").getCategories(), "[cat][b]");
+
+		handle.publish(readIni("a=2\n"));
+		ASSERT_EQ(handle.version(), 1u);
+		ASSERT_EQ(reader->at("a").get<int>(), 2);
+		ASSERT_EQ(handle.acquire()->at("a").get<int>(), 2);
+		// old snapshots stay valid
+		ASSERT_EQ(first->at("a").get<int>(), 1);
+		ASSERT_EQ(first->at("cat").at("b").get<int>(), 2);
+	}
+
+	// copies of snapshot elements are roots, changing them never touches the shared snapshot
+	TEST(ConfigHandleTests, CopyFromSnapshot) {
+		ConfigHandle handle(readIni("a=1\n[cat]\nb=2\nc=3\n"));
+		std::shared_ptr<const Ini> snapshot = handle.acquire();
+		const size_t hash = snapshot->hash();
+
+		Ini copy = snapshot->at("cat");
+		copy["b"] = 5;
+		copy["c"] = std::optional<int>();
+		Ini value = snapshot->at("cat").at("b");
+		value = std::optional<int>();
+
+		ASSERT_FALSE(copy.has("c"));
+		ASSERT_EQ(snapshot->at("cat").at("c").get<int>(), 3);
+		ASSERT_EQ(snapshot->at("cat").at("b").get<int>(), 2);
+		ASSERT_EQ(snapshot->hash(), hash);
+		ASSERT_EQ(*snapshot, readIni("a=1\n[cat]\nb=2\nc=3\n"));
+	}
+
+	TEST(ConfigHandleTests, ConcurrentReaders) {
+		ConfigHandle handle(readIni("a=0\nb=0\n"));
+		std::atomic<bool> stop = false;
+		std::atomic<bool> mismatch = false;
+
+		std::vector<std::thread> readers;
+		for (int i = 0; i < 4; ++i) {
+			readers.emplace_back([&handle, &stop, &mismatch] {
+				ConfigHandle::Reader reader = handle.reader();
+				int last = 0;
+				while (!stop.load()) {
+					const Ini& ini = reader.get();
+					const int a = ini.at("a").get<int>();
+					// every snapshot is consistent and never older than the previous one
+					if (a != ini.at("b").get<int>() || a < last) {
+						mismatch = true;
+					}
+					last = a;
+				}
+			});
+		}
+
+		for (int i = 1; i <= 200; ++i) {
+			Ini ini;
+			ini["a"] = i;
+			ini["b"] = i;
+			handle.publish(std::move(ini));
+		}
+		stop = true;
+		for (std::thread& thread : readers) {
+			thread.join();
+		}
+
+		ASSERT_FALSE(mismatch);
+		ASSERT_EQ(handle.version(), 200u);
+	}
+}
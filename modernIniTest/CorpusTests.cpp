@@ -0,0 +1,74 @@
+#include "pch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../modernIniCorpus/modernIniCorpus.h"
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIniCorpus::CorpusOptions CorpusOptions;
+
+namespace {
+	TEST(CorpusTests, Deterministic) {
+		CorpusOptions options;
+		options.seed = 42;
+		options.maxDepth = 3;
+		options.escapeDensity = 0.05;
+		options.duplicateKeys = 0.1;
+
+		const std::string corpus = modernIniCorpus::generate(options);
+		ASSERT_EQ(modernIniCorpus::generate(options), corpus);
+
+		options.seed = 43;
+		ASSERT_NE(modernIniCorpus::generate(options), corpus);
+
+		options.totalBytes = 100000;
+		const std::string sized = modernIniCorpus::generate(options);
+		ASSERT_GE(sized.size(), 100000u);
+		ASSERT_LT(sized.size(), 101000u);
+	}
+
+	// writing and reading a generated document again keeps every value, including escapes and nested sections
+	TEST(CorpusTests, RoundTrip) {
+		for (uint64_t seed = 1; seed <= 8; ++seed) {
+			CorpusOptions options;
+			options.seed = seed;
+			options.sections = 200;
+			options.maxDepth = 4;
+			options.escapeDensity = 0.05;
+			options.duplicateKeys = 0.1;
+			const std::string corpus = modernIniCorpus::generate(options);
+
+			const Ini ini = readIni(corpus);
+			std::stringstream out;
+			out << ini;
+			ASSERT_EQ(readIni(out.str()), ini) << "seed " << seed;
+		}
+	}
+
+	TEST(CorpusTests, Large) {
+		CorpusOptions options;
+		options.totalBytes = 4 << 20;
+		options.maxDepth = 3;
+		options.escapeDensity = 0.01;
+		const std::string corpus = modernIniCorpus::generate(options);
+
+		auto path = std::filesystem::current_path();
+		path.append("testCorpus.ini");
+		{
+			std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+			stream << corpus;
+		}
+
+		// lines are split differently between the blocks of the stream reader and the async loader
+		const Ini ini = readIni(corpus);
+		ASSERT_EQ(modernIni::async_load_future(path, { .blockSize = 4093 }).get(), ini);
+
+		std::filesystem::remove(path);
+	}
+}
@@ -1,7 +1,17 @@
 #include "pch.h"
 
+#include <array>
+#include <deque>
 #include <filesystem>
 #include <fstream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#if __has_include(<flat_map>)
+#include <flat_map>
+#endif
+#include <vector>
 
 #include "../modernIni/modernIniMacros.h"
 
@@ -45,6 +55,145 @@ namespace {
 		ASSERT_EQ(arr, arrTest);
 	}
 
+	TEST(DefaultContainerTests, stdVectorToIni) {
+		std::vector<int> vec;
+		for (int i = 0; i < 12; ++i) {
+			vec.push_back(i * 2);
+		}
+
+		Ini ini(vec);
+		ASSERT_TRUE(ini.isArray());
+		ASSERT_EQ(ini.size(), 12u);
+		ASSERT_EQ(ini.at(10).get<int>(), 20);
+		ASSERT_EQ(ini.at("11").get<int>(), 22);
+
+		// elements are written in index order
+		std::stringstream ss;
+		ss << ini;
+		ASSERT_EQ(ss.str(), "0=0\n1=2\n2=4\n3=6\n4=8\n5=10\n6=12\n7=14\n8=16\n9=18\n10=20\n11=22\n");
+
+		Ini parsed;
+		ss >> parsed;
+		ASSERT_EQ(parsed, ini);
+		ASSERT_EQ(parsed.get<std::vector<int>>(), vec);
+	}
+
+	TEST(DefaultContainerTests, stdVectorFromIniGaps) {
+		std::stringstream ss("10=5\n0=1\n2=3\nx=7\n");
+		Ini ini;
+		ss >> ini;
+
+		std::vector<int> vec = { 9, 9 };
+		ini.get_to(vec);
+
+		std::vector<int> vecTest(11);
+		vecTest[0] = 1;
+		vecTest[2] = 3;
+		vecTest[10] = 5;
+		ASSERT_EQ(vec, vecTest);
+	}
+
+	TEST(DefaultContainerTests, stdVectorOfObjects) {
+		std::vector<std::map<std::string, int>> vec(2);
+		vec[0]["a"] = 1;
+		vec[1]["b"] = 2;
+
+		Ini ini;
+		ini["list"] = vec;
+
+		std::stringstream ss;
+		ss << ini;
+		ASSERT_EQ(ss.str(), "\n[list][0]\na=1\n\n[list][1]\nb=2\n");
+
+		ASSERT_EQ(ini.at("list").get<decltype(vec)>(), vec);
+	}
+
+	TEST(DefaultContainerTests, stdDequeAndSpan) {
+		std::deque<std::string> deque = { "a", "b", "c" };
+		Ini ini(deque);
+		ASSERT_EQ(ini.get<std::deque<std::string>>(), deque);
+
+		std::array<std::string, 2> buffer;
+		std::span<std::string> span(buffer);
+		ini.get_to(span);
+		ASSERT_EQ(buffer[0], "a");
+		ASSERT_EQ(buffer[1], "b");
+
+		ASSERT_EQ(Ini(std::span<const std::string>(buffer)), Ini(std::vector<std::string>{ "a", "b" }));
+	}
+
+	TEST(DefaultContainerTests, listValue) {
+		std::stringstream ss("weights=0.1,0.25, 0.3 ,1e3\nids=5;6;7\nempty=\n");
+		Ini ini;
+		ss >> ini;
+
+		ASSERT_EQ(ini.at("weights").get<std::vector<double>>(), (std::vector<double>{ 0.1, 0.25, 0.3, 1000 }));
+		ASSERT_EQ(ini.at("ids").get<std::vector<int>>(';'), (std::vector<int>{ 5, 6, 7 }));
+		ASSERT_TRUE(ini.at("empty").get<std::vector<int>>().empty());
+
+		std::array<int, 2> arr = {};
+		ini.at("ids").get_to(arr, ';');
+		ASSERT_EQ(arr, (std::array<int, 2>{ 5, 6 }));
+	}
+
+	struct ListHolder {
+		std::vector<int> ids;
+		int count = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(ListHolder, ids, count)
+	};
+
+	TEST(DefaultContainerTests, listValueInvalid) {
+		std::stringstream ss("ids=1,x,3\nflags=true, off,1\n\n[holder]\nids=1,,3\ncount=2\n");
+		Ini ini;
+		ss >> ini;
+
+		ASSERT_THROW(ini.at("ids").get<std::vector<int>>(), std::invalid_argument);
+		std::array<int, 3> arr = {};
+		ASSERT_THROW(ini.at("ids").get_to(arr), std::invalid_argument);
+
+		ASSERT_EQ(ini.at("flags").get<std::vector<bool>>(), (std::vector<bool>{ true, false, true }));
+		ASSERT_EQ(Ini(std::vector<bool>{ false, true }).get<std::vector<bool>>(), (std::vector<bool>{ false, true }));
+
+		// `noexcept` types skip the field
+		const ListHolder holder = ini.at("holder").get<ListHolder>();
+		ASSERT_EQ(holder.count, 2);
+	}
+
+	TEST(DefaultContainerTests, listValueRoundTrip) {
+		std::vector<float> weights = { 0.5f, -1.25f, 3.f };
+		std::deque<std::string> names = { "a", "b c" };
+
+		Ini ini;
+		ini["weights"].set_list(weights);
+		ini["names"].set_list(names, '|');
+		ASSERT_EQ(ini.at("weights").get<std::string>(), "0.5,-1.25,3");
+
+		std::stringstream ss;
+		ss << ini;
+		Ini parsed;
+		ss >> parsed;
+		ASSERT_EQ(parsed.at("weights").get<std::vector<float>>(), weights);
+		ASSERT_EQ(parsed.at("names").get<std::deque<std::string>>('|'), names);
+	}
+
+	TEST(DefaultContainerTests, arrayIndex) {
+		Ini ini;
+		ini[2] = 5;
+
+		ASSERT_TRUE(ini.isArray());
+		ASSERT_EQ(ini.size(), 3u);
+		ASSERT_EQ(ini.at(2).get<int>(), 5);
+		ASSERT_TRUE(ini.has("1"));
+		ASSERT_FALSE(ini.has("3"));
+		ASSERT_THROW(ini.at(3), std::out_of_range);
+
+		// non-index keys turn it into an object
+		ini["key"] = 1;
+		ASSERT_TRUE(ini.isObject());
+		ASSERT_EQ(ini.at("2").get<int>(), 5);
+	}
+
 	TEST(DefaultContainerTests, stdMapFromIniString) {
 		Ini ini{
 			IniMap {
@@ -222,4 +371,58 @@ namespace {
 
 		ASSERT_EQ(ini, iniTest);
 	}
-}
\ No newline at end of file
+
+	TEST(DefaultContainerTests, stdMapNumSorted) {
+		std::stringstream ss("10=a\n2=b\n1=c\n");
+		Ini ini;
+		ss >> ini;
+
+		std::map<int, std::string> map = { { 2, "old" }, { 5, "kept" } };
+		ini.get_to(map);
+
+		std::map<int, std::string> mapTest{
+			{1, "c"},
+			{2, "b"},
+			{5, "kept"},
+			{10, "a"}
+		};
+		ASSERT_EQ(map, mapTest);
+	}
+
+	TEST(DefaultContainerTests, stdUnorderedMap) {
+		std::unordered_map<std::string, int> map;
+		for (int i = 0; i < 20; ++i) {
+			map["key" + std::to_string(i)] = i;
+		}
+
+		Ini ini(map);
+		ASSERT_EQ(ini.size(), 20u);
+		ASSERT_EQ(ini.get<decltype(map)>(), map);
+
+		// written sorted by key, like `operator<<` does
+		std::stringstream writerOutput;
+		modernIni::IniWriter writer(writerOutput);
+		writer.write(map);
+		std::stringstream iniOutput;
+		iniOutput << ini;
+		ASSERT_EQ(writerOutput.str(), iniOutput.str());
+	}
+
+#ifdef __cpp_lib_flat_map
+	TEST(DefaultContainerTests, stdFlatMap) {
+		std::stringstream ss("10=a\n2=b\n1=c\n");
+		Ini ini;
+		ss >> ini;
+
+		std::flat_map<int, std::string> map;
+		ini.get_to(map);
+		ASSERT_EQ(map.size(), 3u);
+		ASSERT_EQ(map.begin()->second, "c");
+		ASSERT_EQ(map.at(10), "a");
+
+		std::flat_map<std::string, std::string> stringMap;
+		ini.get_to(stringMap);
+		ASSERT_EQ(Ini(stringMap), ini);
+	}
+#endif
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+
+#include <string>
+#include <vector>
+
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniDiff IniDiff;
+typedef std::vector<std::string> Paths;
+
+namespace {
+	TEST(DiffTests, Equal) {
+		const Ini ini = readIni("a=1\n[cat]\nb=2\n[cat][sub]\nc=3\n");
+
+		ASSERT_TRUE(modernIni::diff(ini, ini).empty());
+		ASSERT_TRUE(modernIni::diff(ini, readIni("a=1\n[cat]\nb=2\n[cat][sub]\nc=3\n")).empty());
+	}
+
+	TEST(DiffTests, Changes) {
+		const Ini lhs = readIni("a=1\nb=2\nd=4\n[cat]\nx=1\n[cat][sub]\ny=2\n[old]\nz=1\n");
+		const Ini rhs = readIni("a=1\nb=5\nc=3\n[cat]\nx=1\n[cat][sub]\ny=3\nw=1\n[d]\nv=1\n[new]\nz=1\n");
+
+		const IniDiff result = modernIni::diff(lhs, rhs);
+		ASSERT_EQ(result.added, (Paths{ "c", "[cat][sub]w", "[new]" }));
+		ASSERT_EQ(result.removed, (Paths{ "[old]" }));
+		// a value, that became a section
+		ASSERT_EQ(result.changed, (Paths{ "b", "[cat][sub]y", "[d]" }));
+
+		const IniDiff reverse = modernIni::diff(rhs, lhs);
+		ASSERT_EQ(reverse.added, result.removed);
+		ASSERT_EQ(reverse.removed, result.added);
+		ASSERT_EQ(reverse.changed, (Paths{ "b", "[cat][sub]y", "d" }));
+	}
+
+	// keys are escaped like in the journal, so these paths stay distinct
+	TEST(DiffTests, EscapedKeys) {
+		Ini lhs;
+		lhs["a"]["b]x"] = "1";
+		Ini rhs = lhs;
+		rhs["a]b"]["x"] = "1";
+		rhs["a"]["b]x"] = "2";
+		rhs["c=d"] = "line\nbreak";
+
+		const IniDiff result = modernIni::diff(lhs, rhs);
+		ASSERT_EQ(result.added, (Paths{ "[a\\]b]", "c\\=d" }));
+		ASSERT_EQ(result.changed, (Paths{ "[a]b\\]x" }));
+	}
+
+	TEST(DiffTests, Arrays) {
+		Ini lhs;
+		lhs["list"].resize(3);
+		lhs["list"][0] = 1;
+		lhs["list"][1] = 2;
+		lhs["list"][2] = 3;
+
+		Ini rhs;
+		rhs["list"].resize(2);
+		rhs["list"][0] = 1;
+		rhs["list"][1] = 5;
+
+		IniDiff result = modernIni::diff(lhs, rhs);
+		ASSERT_EQ(result.changed, (Paths{ "[list]1" }));
+		ASSERT_EQ(result.removed, (Paths{ "[list]2" }));
+
+		// arrays are equal to objects with index keys
+		result = modernIni::diff(lhs, readIni("[list]\n0=1\n1=2\n2=3\n"));
+		ASSERT_TRUE(result.empty());
+	}
+}
@@ -0,0 +1,70 @@
+#include "pch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	std::string dump(const Ini& ini) {
+		std::stringstream ss;
+		ss << ini;
+		return ss.str();
+	}
+
+	std::string dumpParallel(const Ini& ini, size_t depth, size_t threads) {
+		std::stringstream ss;
+		modernIni::dump_parallel(ss, ini, depth, threads);
+		return ss.str();
+	}
+
+	TEST(DumpParallelTests, testFile) {
+		auto b = std::filesystem::current_path();
+		b.append("test.ini");
+		std::ifstream stream(b);
+		if (!stream.is_open()) {
+			FAIL() << "test.ini not opened";
+		}
+
+		Ini ini;
+		stream >> ini;
+
+		std::string expected = dump(ini);
+		for (size_t depth = 0; depth < 5; ++depth) {
+			ASSERT_EQ(dumpParallel(ini, depth, 4), expected) << " failed with depth: " << depth;
+		}
+	}
+
+	TEST(DumpParallelTests, manySections) {
+		Ini ini;
+		ini["root"] = "value";
+		for (int i = 0; i < 100; ++i) {
+			Ini& cat = ini["cat" + std::to_string(i)];
+			if (i % 3 != 0) {
+				cat["a"] = i;
+			}
+			for (int j = 0; j < 5; ++j) {
+				Ini& sub = cat["sub" + std::to_string(j)];
+				sub["x"] = i * j;
+				sub["text"] = "line\nbreak";
+				sub["subsub"]["y"] = j;
+			}
+		}
+
+		std::string expected = dump(ini);
+		ASSERT_EQ(dumpParallel(ini, 1, 0), expected);
+		ASSERT_EQ(dumpParallel(ini, 2, 3), expected);
+		ASSERT_EQ(dumpParallel(ini, 3, 8), expected);
+		ASSERT_EQ(dumpParallel(ini, 1, 1), expected);
+	}
+
+	TEST(DumpParallelTests, value) {
+		Ini ini("key", "value");
+
+		ASSERT_EQ(dumpParallel(ini, 1, 2), dump(ini));
+	}
+}
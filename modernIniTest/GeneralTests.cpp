@@ -2,6 +2,8 @@
 
 #include <filesystem>
 #include <fstream>
+#include <sstream>
+#include <streambuf>
 
 import modernIni;
 
@@ -83,6 +85,55 @@ namespace {
 		ASSERT_EQ(ini, testFileIni);
 	}
 
+	// hands out the content in small chunks, like a decompressing `streambuf`
+	class ChunkedStreamBuf : public std::streambuf {
+	private:
+		std::string content;
+		size_t pos = 0;
+		size_t chunkSize;
+
+	protected:
+		int_type underflow() override {
+			if (pos >= content.size()) {
+				return traits_type::eof();
+			}
+			const size_t size = std::min(chunkSize, content.size() - pos);
+			setg(content.data() + pos, content.data() + pos, content.data() + pos + size);
+			pos += size;
+			return traits_type::to_int_type(*gptr());
+		}
+
+	public:
+		ChunkedStreamBuf(std::string new_content, size_t new_chunk_size) :
+			content(std::move(new_content)), chunkSize(new_chunk_size) { }
+	};
+
+	TEST(modernIni, basicReadStreambuf) {
+		auto b = std::filesystem::current_path();
+		b.append("test.ini");
+		std::ifstream file(b);
+		if (!file.is_open()) {
+			FAIL() << "test.ini not opened";
+		}
+		std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		ChunkedStreamBuf buffer(content, 7);
+		std::istream stream(&buffer);
+		Ini ini;
+		stream >> ini;
+		ASSERT_EQ(ini, testFileIni);
+		ASSERT_TRUE(stream.eof());
+
+		// lines longer than one block and no newline at the end
+		const std::string longValue(200000, 'x');
+		ChunkedStreamBuf longBuffer("a=1\nlong=" + longValue + "\n[cat]\nb=2", 4096);
+		std::istream longStream(&longBuffer);
+		Ini longIni;
+		longStream >> longIni;
+		ASSERT_EQ(longIni.at("long").get<std::string>(), longValue);
+		ASSERT_EQ(longIni.at("cat").at("b").get<int>(), 2);
+	}
+
 	TEST(modernIni, basicWrite) {
 		auto inFile = std::filesystem::current_path();
 		inFile.append("test.ini");
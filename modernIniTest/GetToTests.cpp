@@ -227,6 +227,76 @@ x=invalid
 		test(ini, "x", EnumTest2::T0, EnumTest2::T0);
 	}
 
+	// names are not declared in sorted order
+	enum class EnumUnsorted {
+		Red,
+		Green,
+		Blue,
+		Alpha
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumUnsorted, Red, Green, Blue, Alpha)
+
+	TEST(getToTests, enumNameUnsorted) {
+		for (EnumUnsorted val : { EnumUnsorted::Red, EnumUnsorted::Green, EnumUnsorted::Blue, EnumUnsorted::Alpha }) {
+			Ini ini(val);
+			ASSERT_EQ(ini.get<EnumUnsorted>(), val);
+		}
+		ASSERT_EQ(Ini(EnumUnsorted::Blue).get<std::string>(), "Blue");
+		ASSERT_EQ(Ini("Alpha"s).get<EnumUnsorted>(), EnumUnsorted::Alpha);
+		ASSERT_EQ(Ini("Gray"s).get<EnumUnsorted>(), EnumUnsorted::Red);
+	}
+
+	// `Grey` is an alias of `Gray`, the first declared name is written
+	enum class EnumAliased {
+		Gray,
+		Grey = Gray,
+		White
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumAliased, Gray, Grey, White)
+
+	TEST(getToTests, enumNameAliased) {
+		ASSERT_EQ(Ini(EnumAliased::Grey).get<std::string>(), "Gray");
+		ASSERT_EQ(Ini(EnumAliased::White).get<std::string>(), "White");
+		ASSERT_EQ(Ini("Grey"s).get<EnumAliased>(), EnumAliased::Gray);
+		ASSERT_EQ(Ini("White"s).get<EnumAliased>(), EnumAliased::White);
+	}
+
+	// more values than a single counted `MODERN_INI_FOR_EACH` chunk
+	enum class EnumLarge {
+		V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14,
+		V15, V16, V17, V18, V19, V20, V21, V22, V23, V24, V25, V26, V27, V28, V29,
+		V30, V31, V32, V33, V34, V35, V36, V37, V38, V39, V40, V41, V42, V43, V44,
+		V45, V46, V47, V48, V49, V50, V51, V52, V53, V54, V55, V56, V57, V58, V59,
+		V60, V61, V62, V63, V64, V65, V66, V67, V68, V69, V70, V71, V72, V73, V74,
+		V75, V76, V77, V78, V79, V80, V81, V82, V83, V84, V85, V86, V87, V88, V89,
+		V90, V91, V92, V93, V94, V95, V96, V97, V98, V99, V100, V101, V102, V103, V104,
+		V105, V106, V107, V108, V109, V110, V111, V112, V113, V114, V115, V116, V117, V118, V119,
+		V120, V121, V122, V123, V124, V125, V126, V127, V128, V129, V130, V131, V132, V133, V134,
+		V135, V136, V137, V138, V139, V140, V141, V142, V143, V144, V145, V146, V147, V148, V149
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumLarge,
+		V0, V1, V2, V3, V4, V5, V6, V7, V8, V9, V10, V11, V12, V13, V14,
+		V15, V16, V17, V18, V19, V20, V21, V22, V23, V24, V25, V26, V27, V28, V29,
+		V30, V31, V32, V33, V34, V35, V36, V37, V38, V39, V40, V41, V42, V43, V44,
+		V45, V46, V47, V48, V49, V50, V51, V52, V53, V54, V55, V56, V57, V58, V59,
+		V60, V61, V62, V63, V64, V65, V66, V67, V68, V69, V70, V71, V72, V73, V74,
+		V75, V76, V77, V78, V79, V80, V81, V82, V83, V84, V85, V86, V87, V88, V89,
+		V90, V91, V92, V93, V94, V95, V96, V97, V98, V99, V100, V101, V102, V103, V104,
+		V105, V106, V107, V108, V109, V110, V111, V112, V113, V114, V115, V116, V117, V118, V119,
+		V120, V121, V122, V123, V124, V125, V126, V127, V128, V129, V130, V131, V132, V133, V134,
+		V135, V136, V137, V138, V139, V140, V141, V142, V143, V144, V145, V146, V147, V148, V149)
+
+	TEST(getToTests, enumNameLarge) {
+		ASSERT_EQ(Ini(EnumLarge::V0).get<std::string>(), "V0");
+		ASSERT_EQ(Ini(EnumLarge::V100).get<std::string>(), "V100");
+		ASSERT_EQ(Ini(EnumLarge::V149).get<std::string>(), "V149");
+		ASSERT_EQ(Ini("V101"s).get<EnumLarge>(), EnumLarge::V101);
+		ASSERT_EQ(Ini("V149"s).get<EnumLarge>(), EnumLarge::V149);
+	}
+
 	struct object {
 		std::string a;
 		float b;
@@ -647,6 +717,51 @@ y=12.385
 		ASSERT_EQ(obj, objTest);
 	}
 
+	struct unsortedFields {
+		int zeta = 0;
+		int alpha = 0;
+		std::string mid;
+		int beta = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(unsortedFields, zeta, alpha, mid, beta)
+
+		bool operator==(const unsortedFields& rhs) const {
+			return zeta == rhs.zeta
+				&& alpha == rhs.alpha
+				&& mid == rhs.mid
+				&& beta == rhs.beta;
+		}
+	};
+
+	TEST(getToTests, UnsortedFieldsWithUnknownKeys) {
+		std::string iniString = R"(
+aaa=unknown
+alpha=1
+beta=2
+gamma=unknown
+mid=text
+zeta=26
+zzz=unknown
+)";
+
+		unsortedFields objTest{ 26, 1, "text", 2 };
+
+		std::istringstream iniStream(iniString);
+
+		Ini ini;
+
+		iniStream >> ini;
+
+		unsortedFields obj;
+
+		ini.get_to(obj);
+
+		ASSERT_EQ(obj, objTest);
+
+		ini.erase("mid");
+		ASSERT_THROW(ini.get_to(obj), std::out_of_range);
+	}
+
 	TEST(getToTests, Optional) {
 		std::optional<std::string> t;
 		std::optional<std::string> t2 = "test";
@@ -0,0 +1,105 @@
+#include "pch.h"
+
+#include <string>
+#include <unordered_set>
+
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	const std::string iniString = "a=1\nb=2\n\n[cat]\nx=1\n\n[cat][sub]\ny=2\n";
+
+	TEST(HashTests, EqualTrees) {
+		const Ini lhs = readIni(iniString);
+		const Ini rhs = readIni(iniString);
+		ASSERT_EQ(lhs.hash(), rhs.hash());
+		ASSERT_EQ(std::hash<Ini>{}(lhs), lhs.hash());
+
+		ASSERT_NE(lhs.hash(), readIni("a=1\nb=2\n\n[cat]\nx=1\n\n[cat][sub]\ny=3\n").hash());
+		ASSERT_NE(lhs.hash(), readIni("a=1\nb=2\n\n[cat]\nx=1\n\n[cat][sub]\nz=2\n").hash());
+		// a value and an empty section
+		ASSERT_NE(readIni("a=\n").hash(), readIni("[a]\n").hash());
+
+		// arrays are equal to objects with index keys
+		Ini array;
+		array["list"].resize(2);
+		array["list"][0] = 1;
+		array["list"][1] = 2;
+		const Ini object = readIni("[list]\n0=1\n1=2\n");
+		ASSERT_EQ(array, object);
+		ASSERT_EQ(array.hash(), object.hash());
+	}
+
+	TEST(HashTests, Invalidate) {
+		Ini ini = readIni(iniString);
+		const size_t original = ini.hash();
+		const size_t cat = ini.at("cat").hash();
+
+		ini["cat"]["sub"]["y"] = 5;
+		ASSERT_NE(ini.hash(), original);
+		ASSERT_NE(ini.at("cat").hash(), cat);
+		ASSERT_EQ(ini.hash(), readIni("a=1\nb=2\n\n[cat]\nx=1\n\n[cat][sub]\ny=5\n").hash());
+
+		ini["cat"]["sub"]["y"] = 2;
+		ASSERT_EQ(ini.hash(), original);
+
+		ini.at("cat").erase("x");
+		ASSERT_EQ(ini.hash(), readIni("a=1\nb=2\n\n[cat][sub]\ny=2\n").hash());
+
+		ini["new"] = "value";
+		ASSERT_EQ(ini.hash(), readIni("a=1\nb=2\nnew=value\n\n[cat][sub]\ny=2\n").hash());
+	}
+
+	// parents with and without a cached hash on the path to the root
+	TEST(HashTests, InvalidatePartiallyHashed) {
+		Ini ini = readIni(iniString);
+		const size_t original = ini.hash();
+
+		ini["cat"]["sub"]["y"] = 5;
+		// the section is hashed again, the root isn't
+		const size_t cat = ini.at("cat").hash();
+		ini["cat"]["sub"]["y"] = 2;
+		ASSERT_NE(ini.at("cat").hash(), cat);
+		ASSERT_EQ(ini.hash(), original);
+
+		// the whole tree is hashed again, then changed through `at()`
+		ini["cat"]["sub"]["y"] = 7;
+		const size_t changed = ini.hash();
+		ini.at("cat").at("sub").erase("y");
+		ASSERT_NE(ini.hash(), changed);
+		ASSERT_EQ(ini.hash(), readIni("a=1\nb=2\n\n[cat]\nx=1\n\n[cat][sub]\n").hash());
+	}
+
+	TEST(HashTests, Copy) {
+		const Ini original = readIni(iniString);
+		const size_t hash = original.hash();
+
+		Ini copy = original;
+		ASSERT_EQ(copy.hash(), hash);
+		ASSERT_EQ(copy.at("cat").at("sub").at("y").getCategories(), "[cat][sub][y]");
+
+		// changes of the copy don't reach the original
+		copy["cat"]["x"] = 7;
+		ASSERT_NE(copy.hash(), hash);
+		ASSERT_EQ(original.hash(), hash);
+		ASSERT_EQ(original.at("cat").at("x").get<int>(), 1);
+
+		Ini moved = std::move(copy);
+		moved["cat"]["x"] = 1;
+		ASSERT_EQ(moved.hash(), hash);
+		ASSERT_EQ(moved, original);
+	}
+
+	TEST(HashTests, Dedupe) {
+		std::unordered_set<Ini> configs;
+		for (int i = 0; i < 100; ++i) {
+			Ini ini = readIni(iniString);
+			ini["tenant"] = i % 10;
+			configs.insert(std::move(ini));
+		}
+		ASSERT_EQ(configs.size(), 10u);
+	}
+}
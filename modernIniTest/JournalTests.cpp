@@ -0,0 +1,185 @@
+#include "pch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+using std::string_literals::operator ""s;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniJournal IniJournal;
+
+namespace {
+	struct sub1 {
+		float x = 0.f;
+		std::optional<int> y;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub1, x, y)
+	};
+
+	struct optionals {
+		std::optional<int> a;
+		std::optional<std::string> b;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(optionals, a, b)
+	};
+
+	struct paths {
+		std::filesystem::path base;
+		std::filesystem::path journal;
+	};
+
+	paths cleanFiles() {
+		paths result;
+		result.base = std::filesystem::current_path();
+		result.base.append("testJournal.ini");
+		result.journal = result.base;
+		result.journal += ".journal";
+
+		std::filesystem::remove(result.base);
+		std::filesystem::remove(result.journal);
+
+		std::ofstream stream(result.base);
+		stream << "a=1\n\n[cat]\nb=2\nc=3\n";
+		return result;
+	}
+
+	std::string readFile(const std::filesystem::path& path) {
+		std::ifstream stream(path, std::ios::binary);
+		return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	}
+
+	TEST(JournalTests, replay) {
+		paths files = cleanFiles();
+
+		Ini expected;
+		{
+			IniJournal journal(files.base);
+			journal["a"] = 5;
+			journal["cat"]["b"] = "line\nbreak"s;
+			journal["cat"].erase("c");
+			journal["new"]["obj"] = sub1{ 1.5f, 3 };
+			journal["new"]["obj"] = sub1{ 2.5f, std::nullopt };
+			journal["removed"] = "value"s;
+			journal.erase("removed");
+
+			ASSERT_EQ(journal.journal_size(), 7u);
+			ASSERT_EQ(journal["new"]["obj"]["x"].get().get<float>(), 2.5f);
+			ASSERT_FALSE(journal["new"]["obj"].get().has("y"));
+			expected = journal.get();
+		}
+
+		// the base file is untouched
+		ASSERT_EQ(readFile(files.base), "a=1\n\n[cat]\nb=2\nc=3\n");
+
+		IniJournal journal(files.base);
+		ASSERT_EQ(journal.get(), expected);
+		ASSERT_EQ(journal.journal_size(), 7u);
+	}
+
+	TEST(JournalTests, compact) {
+		paths files = cleanFiles();
+
+		IniJournal journal(files.base);
+		journal["cat"]["b"] = 7;
+		journal["cat"]["d"] = true;
+		journal.compact();
+
+		ASSERT_EQ(journal.journal_size(), 0u);
+		ASSERT_EQ(readFile(files.journal), "");
+
+		std::stringstream ss;
+		ss << journal.get();
+		ASSERT_EQ(readFile(files.base), ss.str());
+
+		journal["a"] = 2;
+		IniJournal reopened(files.base);
+		ASSERT_EQ(reopened.get(), journal.get());
+	}
+
+	TEST(JournalTests, incompleteGroup) {
+		paths files = cleanFiles();
+		{
+			IniJournal journal(files.base);
+			journal["a"] = 5;
+		}
+		{
+			// simulate a crash while writing the second change
+			std::ofstream stream(files.journal, std::ios::binary | std::ios::app);
+			stream << "=[cat]b=9\n=[cat]c=";
+		}
+
+		IniJournal journal(files.base);
+		ASSERT_EQ(journal["a"].get().get<int>(), 5);
+		ASSERT_EQ(journal["cat"]["b"].get().get<int>(), 2);
+		ASSERT_EQ(journal.journal_size(), 1u);
+
+		journal["cat"]["c"] = 4;
+		IniJournal reopened(files.base);
+		ASSERT_EQ(reopened.get(), journal.get());
+	}
+
+	// keys with the characters of the record format replay to the same element
+	TEST(JournalTests, escapedKeys) {
+		paths files = cleanFiles();
+		{
+			IniJournal journal(files.base);
+			journal["[cat]"]["a=b"] = 1;
+			journal["x]y"]["back\\slash"] = "v=w"s;
+			journal["[leaf"] = 2;
+			journal["line\nbreak"] = 3;
+			journal["removed=key"] = 4;
+			journal.erase("removed=key");
+		}
+
+		IniJournal journal(files.base);
+		ASSERT_EQ(journal["[cat]"]["a=b"].get().get<int>(), 1);
+		ASSERT_EQ(journal["x]y"]["back\\slash"].get().get<std::string>(), "v=w");
+		ASSERT_EQ(journal["[leaf"].get().get<int>(), 2);
+		ASSERT_EQ(journal["line\nbreak"].get().get<int>(), 3);
+		ASSERT_FALSE(journal.get().has("removed=key"));
+		ASSERT_EQ(journal["cat"]["b"].get().get<int>(), 2);
+	}
+
+	// empty sections have no values, they are replayed as well
+	TEST(JournalTests, emptySections) {
+		paths files = cleanFiles();
+
+		Ini expected;
+		{
+			IniJournal journal(files.base);
+			journal["map"] = std::map<std::string, int>{};
+			journal["opt"] = optionals{};
+			journal["nested"] = std::map<std::string, std::map<std::string, int>>{ { "sub", {} } };
+
+			ASSERT_TRUE(journal["map"].get().isObject());
+			ASSERT_TRUE(journal["opt"].get().isObject());
+			ASSERT_TRUE(journal["nested"]["sub"].get().isObject());
+			expected = journal.get();
+		}
+
+		IniJournal journal(files.base);
+		ASSERT_EQ(journal.get(), expected);
+	}
+
+	TEST(JournalTests, noBaseFile) {
+		paths files = cleanFiles();
+		std::filesystem::remove(files.base);
+
+		{
+			IniJournal journal(files.base);
+			journal["cat"]["a"] = 1;
+		}
+
+		IniJournal journal(files.base);
+		ASSERT_EQ(journal["cat"]["a"].get().get<int>(), 1);
+		ASSERT_TRUE(journal.get().isObject());
+	}
+}
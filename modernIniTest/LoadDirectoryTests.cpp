@@ -0,0 +1,67 @@
+#include "pch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	std::filesystem::path makeDirectory() {
+		auto path = std::filesystem::current_path();
+		path.append("testConf.d");
+		std::filesystem::remove_all(path);
+		std::filesystem::create_directory(path);
+		return path;
+	}
+
+	void writeFile(const std::filesystem::path& path, const std::string& name, const std::string& content) {
+		std::ofstream stream(path / name, std::ios::binary | std::ios::trunc);
+		stream << content;
+	}
+
+	TEST(LoadDirectoryTests, Merge) {
+		const auto path = makeDirectory();
+		writeFile(path, "90-host.ini", "port=9090\n\n[limits]\nconnections=30\n");
+		writeFile(path, "10-defaults.ini", "name=default\nport=80\nmode=a\n\n[limits]\nconnections=10\ntimeout=1.5\n");
+		writeFile(path, "50-site.ini", "mode=b\n\n[site]\nregion=eu\n");
+		writeFile(path, "README.txt", "ignored=1\n");
+
+		const Ini ini = modernIni::load_directory(path);
+		ASSERT_EQ(ini, readIni("name=default\nport=9090\nmode=b\n\n[limits]\nconnections=30\ntimeout=1.5\n\n[site]\nregion=eu\n"));
+		ASSERT_EQ(ini.at("limits").at("timeout").getCategories(), "[limits][timeout]");
+
+		const auto files = modernIni::load_directory_files(path, { "", 2 });
+		ASSERT_EQ(files.size(), 4u);
+		ASSERT_EQ(files.at("README.txt").at("ignored").get<int>(), 1);
+		ASSERT_EQ(files.at("50-site.ini"), readIni("mode=b\n\n[site]\nregion=eu\n"));
+
+		std::filesystem::remove_all(path);
+	}
+
+	TEST(LoadDirectoryTests, ManyFiles) {
+		const auto path = makeDirectory();
+		for (int i = 0; i < 200; ++i) {
+			const std::string number = std::to_string(i);
+			// sorted by name like by number
+			const std::string name = std::string(3 - number.size(), '0') + number + ".ini";
+			writeFile(path, name, "last=" + number + "\n\n[file" + number + "]\nvalue=" + std::to_string(i * 2) + "\n");
+		}
+
+		const Ini ini = modernIni::load_directory(path, { ".ini", 8 });
+		ASSERT_EQ(ini.size(), 201u);
+		ASSERT_EQ(ini.at("last").get<int>(), 199);
+		ASSERT_EQ(ini.at("file42").at("value").get<int>(), 84);
+
+		std::filesystem::remove_all(path);
+	}
+
+	TEST(LoadDirectoryTests, MissingDirectory) {
+		ASSERT_THROW(modernIni::load_directory("doesNotExist.d"), std::filesystem::filesystem_error);
+	}
+}
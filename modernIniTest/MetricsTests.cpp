@@ -0,0 +1,130 @@
+#include "pch.h"
+
+#include <sstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniMetrics IniMetrics;
+
+namespace {
+	struct Limits {
+		int connections = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Limits, connections)
+	};
+
+	struct Server {
+		std::string name;
+		Limits limits;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Server, name, limits)
+	};
+
+	// reports an allocation like a counting `operator new` would
+	struct Allocating {
+		int value = 0;
+
+		friend void from_ini(Allocating& obj, const Ini& ini) {
+			IniMetrics::record_allocation(64);
+			obj.value = ini.get<int>();
+		}
+	};
+
+	const std::string iniString = "name=main\\nserver\n\n[limits]\nconnections=512\n";
+
+	TEST(MetricsTests, Parse) {
+		IniMetrics metrics;
+		Ini ini;
+		{
+			IniMetrics::Scope scope(metrics);
+			std::stringstream ss(iniString);
+			ss >> ini;
+		}
+
+		ASSERT_EQ(metrics.parses, 1u);
+		ASSERT_EQ(metrics.lines, 4u);
+		ASSERT_EQ(metrics.bytesRead, iniString.size());
+		// name, limits and connections
+		ASSERT_EQ(metrics.nodesCreated, 3u);
+		ASSERT_EQ(ini.at("name").get<std::string>(), "main\nserver");
+
+		// merging into an existing tree only counts the new elements
+		{
+			IniMetrics::Scope scope(metrics);
+			std::stringstream ss("name=other\n[limits]\ntimeout=5\n");
+			ss >> ini;
+		}
+		ASSERT_EQ(metrics.parses, 2u);
+		ASSERT_EQ(metrics.nodesCreated, 4u);
+
+		// every level of a nested section is counted once
+		{
+			IniMetrics::Scope scope(metrics);
+			std::stringstream ss("[outer][inner]\nvalue=1\n[outer][inner]\nother=2\n");
+			ss >> ini;
+		}
+		ASSERT_EQ(metrics.nodesCreated, 8u);
+
+		// nothing is recorded without a scope
+		std::stringstream ss(iniString);
+		ss >> ini;
+		ASSERT_EQ(metrics.parses, 3u);
+	}
+
+	TEST(MetricsTests, WriteAndBind) {
+		Ini ini;
+		std::stringstream input(iniString);
+		input >> ini;
+
+		IniMetrics metrics;
+		std::stringstream output;
+		Server server;
+		{
+			IniMetrics::Scope scope(metrics);
+			output << ini;
+			server = ini.get<Server>();
+		}
+
+		ASSERT_EQ(metrics.writes, 1u);
+		ASSERT_EQ(metrics.bytesWritten, output.str().size());
+		ASSERT_EQ(output.str(), iniString);
+		// the nested `Limits` is part of the `Server` binding
+		ASSERT_EQ(metrics.binds, 1u);
+		ASSERT_EQ(server.limits.connections, 512);
+		ASSERT_EQ(metrics.parses, 0u);
+	}
+
+	TEST(MetricsTests, Scopes) {
+		IniMetrics outer;
+		IniMetrics inner;
+		Ini ini;
+		ini["value"] = 5;
+
+		// allocations outside of a recorded operation are ignored
+		IniMetrics::record_allocation(8);
+		{
+			IniMetrics::Scope outerScope(outer);
+			IniMetrics::record_allocation(8);
+			{
+				IniMetrics::Scope innerScope(inner);
+				ASSERT_EQ(ini.at("value").get<Allocating>().value, 5);
+			}
+			ASSERT_EQ(ini.at("value").get<Allocating>().value, 5);
+			ASSERT_EQ(ini.at("value").get<Allocating>().value, 5);
+		}
+
+		ASSERT_EQ(inner.binds, 1u);
+		ASSERT_EQ(inner.allocations, 1u);
+		ASSERT_EQ(inner.allocatedBytes, 64u);
+		ASSERT_EQ(outer.binds, 2u);
+		ASSERT_EQ(outer.allocations, 2u);
+
+		outer += inner;
+		ASSERT_EQ(outer.binds, 3u);
+		ASSERT_EQ(outer.allocatedBytes, 192u);
+	}
+}
@@ -0,0 +1,89 @@
+#include "pch.h"
+
+#include <memory>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniOverlay IniOverlay;
+
+namespace {
+	struct Limits {
+		int connections = 0;
+		float timeout = 0.f;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Limits, connections, timeout)
+	};
+
+	struct Config {
+		std::string name;
+		int port = 0;
+		Limits limits;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Config, name, port, limits)
+	};
+
+	std::shared_ptr<const Ini> readLayer(const std::string& iniString) {
+		return std::make_shared<const Ini>(readIni(iniString));
+	}
+
+	IniOverlay makeOverlay() {
+		return IniOverlay({
+			readLayer("name=default\nport=80\nmode=a\n\n[limits]\nconnections=10\ntimeout=1.5\n\n[mode]\nx=1\n"),
+			readLayer("port=8080\n\n[limits]\nconnections=20\n\n[site]\nregion=eu\n"),
+			readLayer("mode=b\n\n[limits]\nconnections=30\n"),
+		});
+	}
+
+	TEST(OverlayTests, Lookup) {
+		IniOverlay overlay = makeOverlay();
+
+		ASSERT_EQ(overlay.at("name").get<std::string>(), "default");
+		ASSERT_EQ(overlay.at("port").get<int>(), 8080);
+		ASSERT_EQ(overlay.at("limits").at("connections").get<int>(), 30);
+		ASSERT_EQ(overlay["limits"]["timeout"].get<float>(), 1.5f);
+		ASSERT_EQ(overlay.at("site").at("region").get<std::string>(), "eu");
+		ASSERT_TRUE(overlay.has("site"));
+		ASSERT_FALSE(overlay.has("missing"));
+		ASSERT_THROW(overlay.at("missing"), std::out_of_range);
+		ASSERT_THROW(overlay.at("site").at("missing"), std::out_of_range);
+
+		// the value of the top layer hides the section below
+		ASSERT_TRUE(overlay.at("mode").isValue());
+		ASSERT_EQ(overlay.at("mode").get<std::string>(), "b");
+
+		// sections of all layers are merged
+		const Limits limits = overlay.at("limits").get<Limits>();
+		ASSERT_EQ(limits.connections, 30);
+		ASSERT_EQ(limits.timeout, 1.5f);
+	}
+
+	TEST(OverlayTests, Flatten) {
+		IniOverlay overlay = makeOverlay();
+
+		std::shared_ptr<const Ini> flat = overlay.flatten();
+		ASSERT_EQ(*flat, *readLayer("name=default\nport=8080\nmode=b\n\n[limits]\nconnections=30\ntimeout=1.5\n\n[site]\nregion=eu\n"));
+		ASSERT_EQ(flat->at("limits").at("timeout").getCategories(), "[limits][timeout]");
+		// kept until a layer changes
+		ASSERT_EQ(overlay.flatten(), flat);
+		ASSERT_EQ(overlay.get<Config>().limits.connections, 30);
+
+		// merged sections are kept as well
+		ASSERT_EQ(overlay.at("limits").get<Limits>().connections, 30);
+		ASSERT_EQ(overlay.at("limits").get<Limits>().timeout, 1.5f);
+
+		overlay.set_layer(2, readLayer("[limits]\nconnections=40\n"));
+		ASSERT_NE(overlay.flatten(), flat);
+		ASSERT_EQ(overlay.flatten()->at("limits").at("connections").get<int>(), 40);
+		ASSERT_EQ(overlay.at("limits").get<Limits>().connections, 40);
+		ASSERT_EQ(overlay.at("mode").at("x").get<int>(), 1);
+
+		overlay.push_layer(readLayer("port=1\n"));
+		ASSERT_EQ(overlay.size(), 4u);
+		ASSERT_EQ(overlay.flatten()->at("port").get<int>(), 1);
+	}
+}
@@ -0,0 +1,172 @@
+#include "pch.h"
+
+#include <array>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	struct sub1 {
+		float x = 0.f;
+		float y = 0.f;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub1, x, y)
+
+		bool operator==(const sub1&) const = default;
+	};
+
+	struct sub2 {
+		int a = 0;
+		sub1 b;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub2, a, b)
+
+		bool operator==(const sub2&) const = default;
+	};
+
+	struct sub3 {
+		sub2 a;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub3, a)
+
+		bool operator==(const sub3&) const = default;
+	};
+
+	enum class EnumTest {
+		T0,
+		T1
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumTest, T0, T1)
+
+	struct RootElement {
+		std::string a;
+		uint16_t b = 0;
+		bool c = false;
+		EnumTest e = EnumTest::T0;
+		std::optional<int> o;
+		sub1 s1;
+		sub3 s3;
+		std::array<int, 3> arr = {};
+		std::map<std::string, int> m;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(RootElement, a, b, c, e, o, s1, s3, arr, m)
+
+		bool operator==(const RootElement&) const = default;
+	};
+
+	struct RequiredSub {
+		int x = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(RequiredSub, x)
+	};
+
+	struct RequiredRoot {
+		int a = 0;
+		RequiredSub sub;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(RequiredRoot, a, sub)
+	};
+
+	struct ListHolder {
+		std::vector<int> ids;
+		int count = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(ListHolder, ids, count)
+	};
+
+	// the same as reading into an `Ini` first
+	RootElement viaIni(const std::string& iniString) {
+		Ini ini;
+		std::stringstream ss(iniString);
+		ss >> ini;
+		return ini.get<RootElement>();
+	}
+
+	TEST(ParseIntoTests, NestedStructs) {
+		std::string iniString = R"(
+a =  huhu   haha
+b=12
+c=on
+e=T1
+o=7
+unknown=1
+
+[s1]
+x=1.5
+y=-2
+
+[s3][a]
+a=28
+
+[s3][a][b]
+x=1.75
+y=12.5
+
+[unknown][s1]
+x=5
+)";
+
+		RootElement obj = modernIni::parse_into<RootElement>(iniString);
+		ASSERT_EQ(obj.a, "huhu haha");
+		ASSERT_EQ(obj.b, 12);
+		ASSERT_TRUE(obj.c);
+		ASSERT_EQ(obj.e, EnumTest::T1);
+		ASSERT_EQ(obj.o, 7);
+		ASSERT_EQ(obj.s1.x, 1.5f);
+		ASSERT_EQ(obj.s1.y, -2.f);
+		ASSERT_EQ(obj.s3.a.a, 28);
+		ASSERT_EQ(obj.s3.a.b.x, 1.75f);
+		ASSERT_EQ(obj.s3.a.b.y, 12.5f);
+		ASSERT_EQ(obj, viaIni(iniString));
+	}
+
+	TEST(ParseIntoTests, Containers) {
+		std::string iniString = "a=text\\nnext\\\\\n\n[arr]\n0=1\n2=3\n\n[m]\nfirst=1\nsecond=2\n";
+
+		std::stringstream ss(iniString);
+		RootElement obj;
+		modernIni::parse_into(ss, obj);
+
+		ASSERT_EQ(obj.a, "text\nnext\\");
+		ASSERT_EQ(obj.arr, (std::array<int, 3>{ 1, 0, 3 }));
+		ASSERT_EQ(obj.m.size(), 2u);
+		ASSERT_EQ(obj.m.at("second"), 2);
+		ASSERT_EQ(obj, viaIni(iniString));
+	}
+
+	TEST(ParseIntoTests, DuplicateKeys) {
+		std::string iniString = "b=1\nb=2\n\n[s1]\nx=1\n\n[s1]\nx=2\ny=3\n";
+
+		RootElement obj = modernIni::parse_into<RootElement>(iniString);
+		ASSERT_EQ(obj.b, 1);
+		ASSERT_EQ(obj.s1.x, 1.f);
+		ASSERT_EQ(obj.s1.y, 3.f);
+		ASSERT_EQ(obj, viaIni(iniString));
+	}
+
+	TEST(ParseIntoTests, MissingValuesException) {
+		ASSERT_NO_THROW(modernIni::parse_into<RequiredRoot>("a=1\n[sub]\nx=2\n"));
+		ASSERT_THROW(modernIni::parse_into<RequiredRoot>("a=1\n"), std::out_of_range);
+		ASSERT_THROW(modernIni::parse_into<RequiredRoot>("a=1\n[sub]\ny=2\n"), std::out_of_range);
+		ASSERT_THROW(modernIni::parse_into<RequiredRoot>("a=1\nsub=2\n"), std::out_of_range);
+	}
+
+	// `noexcept` types skip an invalid list like `get_to()` does
+	TEST(ParseIntoTests, ListValueInvalid) {
+		ListHolder holder;
+		ASSERT_NO_THROW(modernIni::parse_into("ids=1,x,3\ncount=2\n", holder));
+		ASSERT_EQ(holder.count, 2);
+
+		ASSERT_NO_THROW(modernIni::parse_into("ids=1,2,3\ncount=2\n", holder));
+		ASSERT_EQ(holder.ids, (std::vector<int>{ 1, 2, 3 }));
+	}
+}
@@ -0,0 +1,186 @@
+#include "pch.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+import modernIni;
+
+using std::string_literals::operator ""s;
+
+typedef modernIni::Ini Ini;
+
+namespace {
+	const std::string originalFile = R"(; global comment
+test1 = baumhaus
+test2=haus\nbaum
+
+[cat1]
+; comment
+test1=kuckuck
+test5=ich bin ein text
+
+[cat2][subcat1]
+x=15
+y=7
+)";
+
+	std::filesystem::path writeFile(const std::string& content) {
+		auto path = std::filesystem::current_path();
+		path.append("testIncremental.ini");
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << content;
+		return path;
+	}
+
+	std::string readFile(const std::filesystem::path& path) {
+		std::ifstream stream(path, std::ios::binary);
+		return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	}
+
+	Ini readIni(const std::filesystem::path& path) {
+		std::ifstream stream(path);
+		Ini ini;
+		stream >> ini;
+		return ini;
+	}
+
+	TEST(SaveIncrementalTests, noChanges) {
+		auto path = writeFile(originalFile);
+		Ini ini = readIni(path);
+
+		ini.save_incremental(path);
+
+		ASSERT_EQ(readFile(path), originalFile);
+	}
+
+	TEST(SaveIncrementalTests, sameSize) {
+		auto path = writeFile(originalFile);
+		Ini ini = readIni(path);
+
+		ini["cat1"]["test1"] = "kuckucx"s;
+		ini["test1"] = "baum\nhaus"s;
+		ini.save_incremental(path);
+
+		ASSERT_EQ(readFile(path), R"(; global comment
+test1 = baum\nhaus
+test2=haus\nbaum
+
+[cat1]
+; comment
+test1=kuckucx
+test5=ich bin ein text
+
+[cat2][subcat1]
+x=15
+y=7
+)");
+		ASSERT_EQ(readIni(path), ini);
+	}
+
+	TEST(SaveIncrementalTests, changes) {
+		auto path = writeFile(originalFile);
+		Ini ini = readIni(path);
+
+		ini["cat1"]["test1"] = "Falke"s;
+		ini["cat2"]["subcat1"]["z"] = 3;
+		ini["cat2"]["b"] = 2;
+		ini["cat3"]["a"] = 1;
+		ini["root"] = true;
+		ini.erase("test2");
+		ini.save_incremental(path);
+
+		ASSERT_EQ(readFile(path), R"(; global comment
+test1 = baumhaus
+root=true
+
+[cat1]
+; comment
+test1=Falke
+test5=ich bin ein text
+
+[cat2][subcat1]
+x=15
+y=7
+z=3
+
+[cat2]
+b=2
+
+[cat3]
+a=1
+)");
+		ASSERT_EQ(readIni(path), ini);
+
+		// the second save uses the positions of the new file
+		ini.erase("cat1");
+		ini["cat2"]["subcat1"]["x"] = 150;
+		ini["cat3"]["a"]["sub"] = 5;
+		ini.save_incremental(path);
+
+		// comments and empty sections are kept
+		ASSERT_EQ(readFile(path), R"(; global comment
+test1 = baumhaus
+root=true
+
+; comment
+
+[cat2][subcat1]
+x=150
+y=7
+z=3
+
+[cat2]
+b=2
+
+[cat3]
+
+[cat3][a]
+sub=5
+)");
+		ASSERT_EQ(readIni(path), ini);
+	}
+
+	TEST(SaveIncrementalTests, assign) {
+		auto path = writeFile(originalFile);
+		Ini ini = readIni(path);
+
+		Ini other;
+		std::stringstream ss("[other]\nq=1\nr=2\n");
+		ss >> other;
+
+		// assigned elements keep their own position in the file, the elements of a replaced section are removed
+		ini["test1"] = ini.at("test2");
+		ini["cat1"] = other.at("other");
+		ini["cat2"]["subcat1"]["x"] = other.at("other").at("q");
+		ini.save_incremental(path);
+
+		ASSERT_EQ(readFile(path), R"(; global comment
+test1 = haus\nbaum
+test2=haus\nbaum
+
+[cat1]
+; comment
+q=1
+r=2
+
+[cat2][subcat1]
+x=1
+y=7
+)");
+		ASSERT_EQ(readIni(path), ini);
+		ASSERT_EQ(ini.at("cat1").getCategories(), "[cat1]");
+	}
+
+	TEST(SaveIncrementalTests, noTrailingLineBreak) {
+		auto path = writeFile("[cat]\na=1");
+		Ini ini = readIni(path);
+
+		ini["cat"]["b"] = 2;
+		ini.save_incremental(path);
+
+		ASSERT_EQ(readFile(path), "[cat]\na=1\nb=2\n");
+	}
+}
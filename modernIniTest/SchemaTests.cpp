@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#include <sstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::Schema Schema;
+typedef modernIni::SchemaError SchemaError;
+
+namespace {
+	struct Sub {
+		float x = 0.f;
+		int y = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Sub, x, y)
+	};
+
+	struct Root {
+		int a = 0;
+		bool b = false;
+		Sub sub;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(Root, a, b, sub)
+	};
+
+	struct OptionalRoot {
+		int a = 0;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(OptionalRoot, a)
+	};
+
+	// line of the `SchemaError`, -1 if no error was thrown
+	int errorLine(const std::string& iniString, const Schema& schema) {
+		Ini ini;
+		std::stringstream ss(iniString);
+		try {
+			modernIni::parse(ss, ini, schema);
+		} catch (const SchemaError& e) {
+			return static_cast<int>(e.line());
+		}
+		return -1;
+	}
+
+	TEST(SchemaTests, Manual) {
+		Schema schema;
+		schema.value<int>("", "num")
+			.value("[cat]", "flag", Schema::ValueType::Bool)
+			.value("[cat][sub]", "name", Schema::ValueType::String, false)
+			.range("[cat]", "percent", 0, 100);
+
+		std::string iniString = "num=5\nunknown=x\n\n[cat]\nflag=on\npercent=50\n\n[other]\nnum=text\n";
+		Ini ini;
+		std::stringstream ss(iniString);
+		modernIni::parse(ss, ini, schema);
+
+		Ini expected;
+		std::stringstream ss2(iniString);
+		ss2 >> expected;
+		ASSERT_EQ(ini, expected);
+
+		ASSERT_EQ(errorLine("num=5x\n", schema), 1);
+		ASSERT_EQ(errorLine("num=5\n[cat]\nflag=on\npercent=101\n", schema), 4);
+		ASSERT_EQ(errorLine("num=5\n[cat]\nflag=maybe\n", schema), 3);
+		ASSERT_EQ(errorLine("[num]\n", schema), 1);
+		ASSERT_EQ(errorLine("num=5\ncat=1\n", schema), 2);
+		// only the first occurrence is checked
+		ASSERT_EQ(errorLine("num=5\nnum=x\n[cat]\nflag=1\n", schema), -1);
+	}
+
+	TEST(SchemaTests, Missing) {
+		Schema schema;
+		schema.value<int>("", "num")
+			.section("[cat]")
+			.value<int>("[cat][sub]", "x")
+			.section("[opt]", false)
+			.value<int>("[opt]", "y");
+
+		ASSERT_EQ(errorLine("num=5\n[cat]\n", schema), -1);
+		ASSERT_EQ(errorLine("[cat]\n", schema), 0);
+		ASSERT_EQ(errorLine("num=5\n", schema), 0);
+		ASSERT_EQ(errorLine("num=5\n[cat]\n[cat][sub]\n", schema), 0);
+		ASSERT_EQ(errorLine("num=5\n[cat]\n[opt]\n", schema), 0);
+		ASSERT_EQ(errorLine("num=5\n[cat]\n[opt]\ny=1\n", schema), -1);
+
+		try {
+			Ini ini;
+			std::stringstream ss("[cat]\n");
+			modernIni::parse(ss, ini, schema);
+			FAIL();
+		} catch (const SchemaError& e) {
+			ASSERT_STREQ(e.what(), "Missing key `num`");
+		}
+	}
+
+	TEST(SchemaTests, FromType) {
+		const Schema schema = Schema::from<Root>();
+
+		Root obj;
+		modernIni::parse_into("a=1\nb=true\n[sub]\nx=1.5\ny=2\n", obj, schema);
+		ASSERT_EQ(obj.a, 1);
+		ASSERT_EQ(obj.sub.x, 1.5f);
+
+		ASSERT_EQ(errorLine("a=1\nb=true\n[sub]\nx=1.5\ny=2.5\n", schema), 5);
+		ASSERT_EQ(errorLine("a=1\nb=true\n", schema), 0);
+		ASSERT_THROW(modernIni::parse_into("a=1\nb=yes please\n[sub]\nx=1\ny=2\n", obj, schema), SchemaError);
+
+		const Schema optional = Schema::from<OptionalRoot>();
+		ASSERT_EQ(errorLine("", optional), -1);
+		ASSERT_EQ(errorLine("a=x\n", optional), 1);
+	}
+}
@@ -0,0 +1,19 @@
+//
+// TestHelpers.h
+// Helpers shared by the test files.
+//
+
+#pragma once
+
+#include <sstream>
+#include <string>
+
+import modernIni;
+
+// parses `iniString` like a file read with `operator>>`
+inline modernIni::Ini readIni(const std::string& iniString) {
+	modernIni::Ini ini;
+	std::stringstream ss(iniString);
+	ss >> ini;
+	return ini;
+}
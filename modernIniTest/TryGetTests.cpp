@@ -0,0 +1,111 @@
+#include "pch.h"
+
+#include <optional>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+#include "TestHelpers.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniError IniError;
+
+namespace {
+	enum class EnumTest {
+		T0,
+		T1
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumTest, T0, T1)
+
+	const std::string iniString = R"(
+num=5
+float=1.5
+partial=5x
+text=hello
+flag=on
+enum=T1
+wrongEnum=T7
+
+[cat]
+x=1
+)";
+
+	TEST(TryGetTests, Find) {
+		Ini ini = readIni(iniString);
+
+		const Ini* num = ini.find("num");
+		ASSERT_NE(num, nullptr);
+		ASSERT_EQ(num->get<int>(), 5);
+		ASSERT_EQ(ini.find("missing"), nullptr);
+		ASSERT_NE(ini.find("cat"), nullptr);
+		// values have no sub elements
+		ASSERT_EQ(num->find("num"), nullptr);
+
+		ini.find("cat")->operator[]("y") = 2;
+		ASSERT_EQ(ini.at("cat").at("y").get<int>(), 2);
+	}
+
+	TEST(TryGetTests, TryGetTo) {
+		Ini ini = readIni(iniString);
+		IniError error = IniError::MissingKey;
+
+		int num = 0;
+		ASSERT_TRUE(ini.try_get_to("num", num, error));
+		ASSERT_EQ(num, 5);
+
+		ASSERT_FALSE(ini.try_get_to("missing", num, error));
+		ASSERT_EQ(error, IniError::MissingKey);
+		ASSERT_FALSE(ini.try_get_to("cat", num, error));
+		ASSERT_EQ(error, IniError::WrongType);
+		ASSERT_FALSE(ini.try_get_to("partial", num, error));
+		ASSERT_EQ(error, IniError::ParseError);
+		ASSERT_FALSE(ini.try_get_to("text", num, error));
+		ASSERT_EQ(error, IniError::ParseError);
+
+		bool flag = false;
+		ASSERT_TRUE(ini.try_get_to("flag", flag, error));
+		ASSERT_TRUE(flag);
+		ASSERT_FALSE(ini.try_get_to("text", flag, error));
+		ASSERT_EQ(error, IniError::ParseError);
+
+		EnumTest e = EnumTest::T0;
+		ASSERT_TRUE(ini.try_get_to("enum", e, error));
+		ASSERT_EQ(e, EnumTest::T1);
+		ASSERT_FALSE(ini.try_get_to("wrongEnum", e, error));
+		ASSERT_EQ(error, IniError::ParseError);
+
+		std::map<std::string, int> map;
+		ASSERT_TRUE(ini.try_get_to("cat", map, error));
+		ASSERT_EQ(map.at("x"), 1);
+		ASSERT_FALSE(ini.try_get_to("num", map, error));
+		ASSERT_EQ(error, IniError::WrongType);
+	}
+
+#ifdef __cpp_lib_expected
+	TEST(TryGetTests, TryGet) {
+		Ini ini = readIni(iniString);
+
+		auto num = ini.try_get<int>("num");
+		ASSERT_TRUE(num.has_value());
+		ASSERT_EQ(*num, 5);
+		ASSERT_EQ(ini.try_get<float>("float").value(), 1.5f);
+		ASSERT_EQ(ini.try_get<int>("missing").error(), IniError::MissingKey);
+		ASSERT_EQ(ini.try_get<std::string>("cat").error(), IniError::WrongType);
+		ASSERT_EQ(ini.try_get<int>("partial").error(), IniError::ParseError);
+	}
+#endif
+
+	TEST(TryGetTests, GetOr) {
+		Ini ini = readIni(iniString);
+
+		ASSERT_EQ(ini.get_or("num", 1), 5);
+		ASSERT_EQ(ini.get_or("missing", 1), 1);
+		ASSERT_EQ(ini.get_or("text", 1), 1);
+		ASSERT_EQ(ini.get_or("text", "default"), "hello");
+		ASSERT_EQ(ini.get_or("missing", "default"), "default");
+		ASSERT_EQ(ini.get_or("cat", std::optional<int>()), std::nullopt);
+		ASSERT_EQ(ini.get_or("num", std::optional<int>()), 5);
+	}
+}
@@ -0,0 +1,166 @@
+#include "pch.h"
+
+#if defined(__linux__) || defined(_WIN32)
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniWatcher IniWatcher;
+
+namespace {
+	std::filesystem::path writeFile(const std::string& content) {
+		auto path = std::filesystem::current_path();
+		path.append("testWatcher.ini");
+
+		std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+		stream << content;
+		return path;
+	}
+
+	// collects the changes of a callback
+	struct Changes {
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::vector<std::string> paths;
+
+		void add(const std::string& path, const Ini* value) {
+			std::lock_guard lock(mutex);
+			paths.push_back(value != nullptr ? path + "=" + value->get<std::string>() : path);
+			condition.notify_all();
+		}
+
+		std::vector<std::string> wait(size_t count) {
+			std::unique_lock lock(mutex);
+			condition.wait_for(lock, std::chrono::seconds(5), [this, count] {
+				return paths.size() >= count;
+			});
+			return paths;
+		}
+	};
+
+	TEST(WatcherTests, Callbacks) {
+		const auto path = writeFile("a=1\nb=2\n\n[cat]\nx=1\ny=2\n");
+		IniWatcher watcher(path, std::chrono::milliseconds(20));
+		ASSERT_EQ(watcher.handle().acquire()->at("cat").at("x").get<int>(), 1);
+
+		Changes all;
+		Changes cat;
+		Changes a;
+		watcher.on_change("", [&all](const std::string& changed, const Ini* value) {
+			all.add(changed, value);
+		});
+		watcher.on_change("[cat]", [&cat](const std::string& changed, const Ini* value) {
+			cat.add(changed, value);
+		});
+		watcher.on_change("a", [&a](const std::string& changed, const Ini* value) {
+			a.add(changed, value);
+		});
+
+		writeFile("a=1\nb=3\n\n[cat]\nx=1\nz=5\n");
+
+		// removed, added, then changed elements
+		ASSERT_EQ(all.wait(3), (std::vector<std::string>{ "[cat]y", "[cat]z=5", "b=3" }));
+		ASSERT_EQ(cat.wait(2), (std::vector<std::string>{ "[cat]y", "[cat]z=5" }));
+		ASSERT_TRUE(a.paths.empty());
+		ASSERT_EQ(watcher.handle().acquire()->at("b").get<int>(), 3);
+
+		Changes x;
+		watcher.on_change("[cat]x", [&x](const std::string& changed, const Ini* value) {
+			x.add(changed, value);
+		});
+		writeFile("a=1\nb=3\n");
+
+		// the whole section is removed
+		ASSERT_EQ(x.wait(1), std::vector<std::string>{ "[cat]" });
+		ASSERT_EQ(all.wait(4).back(), "[cat]");
+
+		std::filesystem::remove(path);
+	}
+
+	// callbacks are called without the lock, so they can register further callbacks
+	TEST(WatcherTests, RegisterInCallback) {
+		const auto path = writeFile("a=1\n");
+		IniWatcher watcher(path, std::chrono::milliseconds(20));
+
+		Changes first;
+		Changes second;
+		watcher.on_change("a", [&watcher, &first, &second](const std::string& changed, const Ini* value) {
+			if (first.paths.empty()) {
+				watcher.on_change("a", [&second](const std::string& changed, const Ini* value) {
+					second.add(changed, value);
+				});
+			}
+			first.add(changed, value);
+		});
+
+		writeFile("a=2\n");
+		ASSERT_EQ(first.wait(1), std::vector<std::string>{ "a=2" });
+		// only added for the next reload
+		ASSERT_TRUE(second.paths.empty());
+
+		writeFile("a=3\n");
+		ASSERT_EQ(second.wait(1), std::vector<std::string>{ "a=3" });
+		ASSERT_EQ(first.wait(2).back(), "a=3");
+
+		std::filesystem::remove(path);
+	}
+
+	// the file is created after the watcher started, its sections are reported as added
+	TEST(WatcherTests, MissingFile) {
+		auto path = std::filesystem::current_path();
+		path.append("testWatcher.ini");
+		std::filesystem::remove(path);
+
+		IniWatcher watcher(path, std::chrono::milliseconds(20));
+		ASSERT_TRUE(watcher.handle().acquire()->isObject());
+
+		Changes all;
+		Changes x;
+		watcher.on_change("", [&all](const std::string& changed, const Ini* value) {
+			all.add(changed, value);
+		});
+		watcher.on_change("[cat]x", [&x](const std::string& changed, const Ini* value) {
+			x.add(changed, value);
+		});
+
+		writeFile("a=1\n\n[cat]\nx=2\n");
+
+		ASSERT_EQ(x.wait(1), std::vector<std::string>{ "[cat]=" });
+		ASSERT_EQ(all.wait(2), (std::vector<std::string>{ "a=1", "[cat]=" }));
+		ASSERT_EQ(watcher.handle().acquire()->at("cat").at("x").get<int>(), 2);
+
+		std::filesystem::remove(path);
+	}
+
+	TEST(WatcherTests, Rename) {
+		const auto path = writeFile("a=1\n");
+		IniWatcher watcher(path, std::chrono::milliseconds(20));
+
+		Changes changes;
+		watcher.on_change("a", [&changes](const std::string& changed, const Ini* value) {
+			changes.add(changed, value);
+		});
+
+		// editors write a temporary file and rename it
+		auto tempPath = path;
+		tempPath += ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			stream << "a=2\n";
+		}
+		std::filesystem::rename(tempPath, path);
+
+		ASSERT_EQ(changes.wait(1), std::vector<std::string>{ "a=2" });
+
+		std::filesystem::remove(path);
+	}
+}
+#endif
@@ -0,0 +1,155 @@
+#include "pch.h"
+
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+
+#include "../modernIni/modernIniMacros.h"
+
+import modernIni;
+
+typedef modernIni::Ini Ini;
+typedef modernIni::IniWriter IniWriter;
+typedef std::map<std::string, Ini> IniMap;
+
+using std::literals::string_literals::operator""s;
+
+namespace {
+	struct sub1 {
+		float x = 0.f;
+		float y = 0.f;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub1, x, y)
+	};
+
+	struct sub2 {
+		int a = 0;
+		sub1 b;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub2, a, b)
+	};
+
+	struct sub3 {
+		sub2 a;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE_NO_EXCEPT(sub3, a)
+	};
+
+	struct RootElement {
+		std::string a = "huhu";
+		uint16_t b = 5;
+		sub1 c;
+		sub3 d;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(RootElement, a, b, c, d)
+	};
+
+	// sections are declared before values
+	struct UnorderedElement {
+		sub1 c;
+		std::string a = "huhu\nhaha";
+		std::optional<int> o;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(UnorderedElement, c, a, o)
+	};
+
+	enum class EnumTest {
+		T0,
+		T1
+	};
+
+	MODERN_INI_SERIALIZE_ENUM(EnumTest, T0, T1)
+
+	struct EnumElement {
+		EnumTest e = EnumTest::T1;
+
+		MODERN_INI_DEFINE_TYPE_INTRUSIVE(EnumElement, e)
+	};
+
+	std::string writeIni(const Ini& ini) {
+		std::stringstream ss;
+		ss << ini;
+		return ss.str();
+	}
+
+	TEST(WriterTests, MultiObjects) {
+		RootElement obj = {
+			"huhu",
+			8,
+			{
+				0.5,
+				0.685
+			},
+			{
+				28,
+				{
+					1.75,
+					12.385
+				}
+			}
+		};
+
+		std::stringstream ss;
+		IniWriter writer(ss);
+		writer.write(obj);
+
+		ASSERT_EQ(ss.str(), writeIni(Ini(obj)));
+	}
+
+	TEST(WriterTests, ValuesBeforeSections) {
+		UnorderedElement obj;
+		obj.c.x = 1.5f;
+
+		std::stringstream ss;
+		IniWriter writer(ss);
+		writer.write(obj);
+
+		ASSERT_EQ(ss.str(), "a=huhu\\nhaha\n\n[c]\nx=1.5\ny=0\n");
+
+		Ini ini;
+		ss >> ini;
+		ASSERT_EQ(ini, Ini(obj));
+	}
+
+	TEST(WriterTests, EnumName) {
+		std::stringstream ss;
+		IniWriter writer(ss);
+		writer.write(EnumElement());
+
+		ASSERT_EQ(ss.str(), "e=T1\n");
+	}
+
+	TEST(WriterTests, MapOfObjects) {
+		std::map<std::string, RootElement> map;
+		map["first"].b = 1;
+		map["second"].c.y = 2.5f;
+
+		std::stringstream ss;
+		IniWriter writer(ss);
+		writer.write(map);
+
+		ASSERT_EQ(ss.str(), writeIni(Ini(map)));
+	}
+
+	TEST(WriterTests, Sections) {
+		std::stringstream ss;
+		IniWriter writer(ss);
+
+		writer.write("a", 5);
+		writer.begin_section("cat");
+		writer.begin_section("empty");
+		writer.end_section();
+		writer.write("b", "line\nbreak\\"s);
+		writer.begin_section("sub");
+		writer.write("c", true);
+		writer.end_section();
+		writer.write("d", 1.5);
+		writer.end_section();
+
+		ASSERT_EQ(ss.str(), "a=5\n\n[cat]\nb=line\\nbreak\\\\\n\n[cat][sub]\nc=true\n\n[cat]\nd=1.5\n");
+
+		ASSERT_THROW(writer.write("e", 1), std::logic_error);
+		ASSERT_THROW(writer.end_section(), std::logic_error);
+	}
+}